@@ -21,10 +21,9 @@ template <> struct LookupName<Quantity<std::ratio<0>, std::ratio<0>, std::ratio<
         using Named = Angle;
 };
 
-inline std::ostream& operator<<(std::ostream& os, const Angle& quantity) {
-    os << quantity.internal() << " rad";
-    return os;
-}
+template <> struct UnitSuffix<Angle> {
+        static constexpr std::string_view value = " rad";
+};
 
 /**
  * @brief DO NOT USE
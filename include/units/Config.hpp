@@ -0,0 +1,276 @@
+#pragma once
+
+#include "units/Parse.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <string_view>
+
+namespace units {
+/**
+ * @struct ConfigKey
+ *
+ * @brief the key of a config value, with its hash
+ *
+ * A ConfigKey created from a string literal is hashed at compile time, so looking it up costs only the probe and a
+ * string comparison.
+ */
+struct ConfigKey {
+        std::string_view name; /** the key */
+        std::uint32_t hash; /** the hash of the key, from hashString */
+
+        /**
+         * @brief Construct a new ConfigKey object from a string literal, hashed at compile time
+         *
+         * @param name the key
+         */
+        consteval ConfigKey(const char* name) : name(name), hash(hashString(name)) {}
+
+        /**
+         * @brief Construct a new ConfigKey object from a string that is only known at runtime
+         *
+         * @param name the key. Must outlive the ConfigKey
+         */
+        constexpr explicit ConfigKey(std::string_view name) : name(name), hash(hashString(name)) {}
+};
+
+/**
+ * @class Config
+ *
+ * @brief a typed config file, loaded with a single read
+ *
+ * The file is read with 1 fread into a fixed size arena. Loading only finds the keys, and indexes them by hash. A value
+ * is parsed with units::parse on first access, with its dimensions checked, so a value of "3 rpm" read as a Length is
+ * an error instead of a silently wrong constant. The parsed value is cached with its dimensions, so reading it again
+ * as the same dimensions is just the lookup. Nothing is allocated. Reads aren't thread safe, since they fill the cache.
+ *
+ * If the file doesn't fit in the arena, the line it was cut off in is dropped, so a value like "12000000" is never read
+ * as "12".
+ *
+ * A quantity type without a named unit, like a Divided<Voltage, Length> PID gain, is written as a bare number in base
+ * units.
+ *
+ * Each line is a key, an '=', and a value. Whitespace around keys and values is ignored, and '#' starts a comment.
+ * If a key appears more than once, the last value is used.
+ * @code
+ * # /usd/config.txt
+ * wheelDiameter = 3.25 in
+ * gearRatio = 0.75
+ * kP = 1200 # volts per meter
+ * @endcode
+ * @code
+ * units::Config config;
+ * config.load("/usd/config.txt");
+ * Length wheelDiameter = config.get("wheelDiameter", 2.75_in);
+ * std::optional<Number> ratio = config.get<Number>("gearRatio");
+ * std::optional<Divided<Voltage, Length>> kP = config.get<Divided<Voltage, Length>>("kP");
+ * @endcode
+ *
+ * @tparam ArenaSize the maximum size of the file, in bytes
+ * @tparam MaxKeys the maximum number of keys
+ */
+template <std::size_t ArenaSize = 4096, std::size_t MaxKeys = 64> class Config {
+        static constexpr std::size_t slotCount = std::bit_ceil(2 * MaxKeys);
+    public:
+        /**
+         * @brief load a config file, replacing anything loaded before
+         *
+         * @param path the path of the file, e.g "/usd/config.txt"
+         * @return true the whole file was loaded
+         * @return false the file couldn't be opened, or it has more than ArenaSize bytes or MaxKeys keys. Keys in the
+         * part that was loaded can still be read
+         */
+        bool load(const char* path) {
+            clear();
+            std::FILE* file = std::fopen(path, "rb");
+            if (file == nullptr) return false;
+            size = std::fread(arena.data(), 1, arena.size(), file);
+            const bool complete = size < arena.size() || std::fgetc(file) == EOF;
+            std::fclose(file);
+            if (!complete) dropPartialLine();
+            return index() && complete;
+        }
+
+        /**
+         * @brief load a config from text in memory, replacing anything loaded before
+         *
+         * @param text the text. It is copied
+         * @return true the whole text was loaded
+         * @return false the text has more than ArenaSize bytes or MaxKeys keys. Keys in the part that was loaded can
+         * still be read
+         */
+        constexpr bool loadText(std::string_view text) {
+            clear();
+            size = std::min(text.size(), arena.size());
+            std::copy_n(text.data(), size, arena.data());
+            const bool complete = size == text.size();
+            if (!complete) dropPartialLine();
+            return index() && complete;
+        }
+
+        /**
+         * @brief check whether a key exists
+         *
+         * @param key the key
+         * @return true the key exists
+         * @return false the key doesn't exist
+         */
+        constexpr bool contains(ConfigKey key) const { return find(key) != nullptr; }
+
+        /**
+         * @brief get the text of a value, e.g to read a name
+         *
+         * @param key the key
+         * @return std::optional<std::string_view> the text, or std::nullopt if the key doesn't exist. Points into the
+         * arena, so it is valid until the next load
+         */
+        constexpr std::optional<std::string_view> text(ConfigKey key) const {
+            const Entry* entry = find(key);
+            if (entry == nullptr) return std::nullopt;
+            return valueOf(*entry);
+        }
+
+        /**
+         * @brief get a value
+         *
+         * @tparam Q the quantity type of the value
+         * @param key the key
+         * @return std::optional<Q> the value, or std::nullopt if the key doesn't exist, or its value can't be parsed as
+         * a Q
+         */
+        template <isQuantity Q> std::optional<Q> get(ConfigKey key) const {
+            const Entry* entry = find(key);
+            if (entry == nullptr) return std::nullopt;
+            if (entry->parsed && entry->dimensions == dimensionsOf<Q>()) return Q(entry->value);
+            const std::optional<Q> value = parse<Q>(valueOf(*entry));
+            if (value) {
+                entry->value = value->internal();
+                entry->dimensions = dimensionsOf<Q>();
+                entry->parsed = true;
+            }
+            return value;
+        }
+
+        /**
+         * @brief get a value, or a default if it's missing or invalid
+         *
+         * @param key the key
+         * @param fallback the default
+         * @return Q
+         */
+        template <isQuantity Q> Q get(ConfigKey key, Q fallback) const { return get<Q>(key).value_or(fallback); }
+
+        /**
+         * @brief get the number of keys
+         *
+         * @return std::size_t
+         */
+        constexpr std::size_t keyCount() const { return count; }
+    private:
+        struct Entry {
+                std::uint32_t hash = 0;
+                std::uint32_t keyStart = 0;
+                std::uint32_t valueStart = 0;
+                std::uint32_t keyLength = 0; /** 0 if the slot is empty */
+                std::uint32_t valueLength = 0;
+                // the value parsed by the last successful get, in base units. Filled in by get, which is const
+                mutable double value = 0;
+                mutable std::array<std::int8_t, 16> dimensions {}; /** the dimensions the value was parsed as */
+                mutable bool parsed = false; /** whether value holds the parsed value */
+        };
+
+        /**
+         * @brief find the entry of a key
+         */
+        constexpr const Entry* find(ConfigKey key) const {
+            for (std::size_t i = key.hash % slotCount;; i = (i + 1) % slotCount) {
+                const Entry& entry = slots[i];
+                if (entry.keyLength == 0) return nullptr;
+                if (entry.hash == key.hash && keyOf(entry) == key.name) return &entry;
+            }
+        }
+
+        constexpr std::string_view keyOf(const Entry& entry) const {
+            return std::string_view(arena.data() + entry.keyStart, entry.keyLength);
+        }
+
+        constexpr std::string_view valueOf(const Entry& entry) const {
+            return std::string_view(arena.data() + entry.valueStart, entry.valueLength);
+        }
+
+        constexpr void clear() {
+            slots.fill(Entry());
+            count = 0;
+            size = 0;
+        }
+
+        /**
+         * @brief drop the line the arena was cut off in, so that its value isn't read cut short
+         */
+        constexpr void dropPartialLine() {
+            const std::size_t lastNewline = std::string_view(arena.data(), size).rfind('\n');
+            size = lastNewline == std::string_view::npos ? 0 : lastNewline + 1;
+        }
+
+        /**
+         * @brief find every key in the arena, and add it to the hash table
+         *
+         * @return false if there are more than MaxKeys keys
+         */
+        constexpr bool index() {
+            const std::string_view all(arena.data(), size);
+            std::size_t lineStart = 0;
+            while (lineStart < all.size()) {
+                std::size_t lineEnd = all.find('\n', lineStart);
+                if (lineEnd == std::string_view::npos) lineEnd = all.size();
+                std::string_view line = all.substr(lineStart, lineEnd - lineStart);
+                line = line.substr(0, line.find('#'));
+                const std::size_t equals = line.find('=');
+                if (equals != std::string_view::npos) {
+                    const std::string_view key = trim(line.substr(0, equals));
+                    const std::string_view value = trim(line.substr(equals + 1));
+                    if (!key.empty() && !insert(key, value)) return false;
+                }
+                lineStart = lineEnd + 1;
+            }
+            return true;
+        }
+
+        /**
+         * @brief add a key to the hash table, or replace its value
+         *
+         * @return false if the table is full
+         */
+        constexpr bool insert(std::string_view key, std::string_view value) {
+            const std::uint32_t hash = hashString(key);
+            for (std::size_t i = hash % slotCount;; i = (i + 1) % slotCount) {
+                Entry& entry = slots[i];
+                if (entry.keyLength != 0 && (entry.hash != hash || keyOf(entry) != key)) continue;
+                if (entry.keyLength == 0) {
+                    if (count == MaxKeys) return false;
+                    count++;
+                }
+                entry = {hash,
+                         static_cast<std::uint32_t>(key.data() - arena.data()),
+                         static_cast<std::uint32_t>(value.data() - arena.data()),
+                         static_cast<std::uint32_t>(key.size()),
+                         static_cast<std::uint32_t>(value.size())};
+                return true;
+            }
+        }
+
+        static constexpr std::string_view trim(std::string_view text) {
+            const std::size_t first = text.find_first_not_of(" \t\r");
+            if (first == std::string_view::npos) return text.substr(text.size());
+            return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+        }
+
+        std::array<char, ArenaSize> arena;
+        std::size_t size = 0; /** bytes of the arena in use */
+        std::array<Entry, slotCount> slots {};
+        std::size_t count = 0; /** keys in the hash table */
+};
+} // namespace units
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "pros/abstract_motor.hpp"
+#include "units/Angle.hpp"
+#include <span>
+
+namespace units {
+/**
+ * @class DCMotorModel
+ *
+ * @brief a steady state model of a brushed DC motor
+ *
+ * The model is built from the 4 numbers found on a motor datasheet. Its resistance, torque constant, and back EMF
+ * constant are derived once on construction, so every evaluation is a couple of multiply-adds.
+ *
+ * Torque is the torque produced at the output shaft, including the torque lost to friction (modelled by the free
+ * current), so a motor spinning freely produces 0 torque. Friction opposes the direction of motion, or the direction
+ * the motor is driven in when it isn't moving, so the model is symmetric in both directions.
+ */
+class DCMotorModel {
+    public:
+        /**
+         * @brief Construct a new DCMotorModel object
+         *
+         * @param nominalVoltage the voltage the other parameters were measured at
+         * @param stallTorque the torque at 0 speed
+         * @param stallCurrent the current at 0 speed
+         * @param freeSpeed the speed with no load
+         * @param freeCurrent the current with no load
+         */
+        constexpr DCMotorModel(Voltage nominalVoltage, Torque stallTorque, Current stallCurrent,
+                               AngularVelocity freeSpeed, Current freeCurrent)
+            : resistance(nominalVoltage.internal() / stallCurrent.internal()),
+              invResistance(stallCurrent.internal() / nominalVoltage.internal()),
+              kT(stallTorque.internal() / (stallCurrent.internal() - freeCurrent.internal())),
+              kE((nominalVoltage.internal() - freeCurrent.internal() * resistance) / freeSpeed.internal()),
+              freeCurrent(freeCurrent.internal()) {}
+
+        /**
+         * @brief create a model of a V5 smart motor
+         *
+         * Uses the published 2.1 Nm stall torque with the 36:1 cartridge, scaled to the other cartridges, and the 2.5A
+         * current limit of the V5 firmware as the stall current.
+         *
+         * @param gears the cartridge of the motor
+         * @return DCMotorModel
+         */
+        constexpr static DCMotorModel v5(pros::MotorGears gears) {
+            double ratio = 36;
+            if (gears == pros::MotorGears::green) ratio = 18;
+            else if (gears == pros::MotorGears::blue) ratio = 6;
+            return DCMotorModel(12_volt, from_Nm(2.1 * ratio / 36), 2.5_amp, 3600_rpm / ratio, 0.1_amp);
+        }
+
+        /**
+         * @brief get the speed the motor spins at with no load
+         *
+         * @param voltage the applied voltage
+         * @return AngularVelocity
+         */
+        constexpr AngularVelocity freeSpeed(Voltage voltage) const {
+            return AngularVelocity((voltage.internal() - friction(0, voltage.internal()) * resistance) / kE);
+        }
+
+        /**
+         * @brief get the torque the motor produces at 0 speed
+         *
+         * @param voltage the applied voltage
+         * @return Torque
+         */
+        constexpr Torque stallTorque(Voltage voltage) const {
+            return Torque(kT * (voltage.internal() * invResistance - friction(0, voltage.internal())));
+        }
+
+        /**
+         * @brief get the current drawn by the motor
+         *
+         * @param speed the speed of the motor
+         * @param voltage the applied voltage
+         * @return Current
+         */
+        constexpr Current current(AngularVelocity speed, Voltage voltage) const {
+            return Current((voltage.internal() - kE * speed.internal()) * invResistance);
+        }
+
+        /**
+         * @brief get the torque produced by the motor
+         *
+         * @param speed the speed of the motor
+         * @param voltage the applied voltage
+         * @return Torque
+         */
+        constexpr Torque torque(AngularVelocity speed, Voltage voltage) const {
+            return Torque(kT * ((voltage.internal() - kE * speed.internal()) * invResistance -
+                                friction(speed.internal(), voltage.internal())));
+        }
+
+        /**
+         * @brief get the voltage needed to produce a torque at a speed
+         *
+         * @param speed the speed of the motor
+         * @param torque the torque to produce
+         * @return Voltage
+         */
+        constexpr Voltage voltage(AngularVelocity speed, Torque torque) const {
+            const double current = torque.internal() / kT + friction(speed.internal(), torque.internal());
+            return Voltage(current * resistance + kE * speed.internal());
+        }
+
+        /**
+         * @brief get the voltage needed to accelerate a load at a speed
+         *
+         * @param speed the speed of the motor
+         * @param acceleration the acceleration of the motor
+         * @param inertia the moment of inertia of the load, as seen by the motor
+         * @return Voltage
+         */
+        constexpr Voltage voltage(AngularVelocity speed, AngularAcceleration acceleration, Inertia inertia) const {
+            return voltage(speed, Torque(inertia.internal() * acceleration.internal()));
+        }
+
+        /**
+         * @brief get the current drawn by many motors of this model
+         *
+         * @param speeds the speed of each motor
+         * @param voltages the voltage applied to each motor
+         * @param out buffer for the current drawn by each motor
+         */
+        constexpr void currents(std::span<const AngularVelocity> speeds, std::span<const Voltage> voltages,
+                                std::span<Current> out) const {
+            for (std::size_t i = 0; i < speeds.size(); i++) out[i] = current(speeds[i], voltages[i]);
+        }
+
+        /**
+         * @brief get the voltages needed to produce torques with many motors of this model
+         *
+         * @param speeds the speed of each motor
+         * @param torques the torque to produce with each motor
+         * @param out buffer for the voltage to apply to each motor
+         */
+        constexpr void voltages(std::span<const AngularVelocity> speeds, std::span<const Torque> torques,
+                                std::span<Voltage> out) const {
+            for (std::size_t i = 0; i < speeds.size(); i++) out[i] = voltage(speeds[i], torques[i]);
+        }
+    private:
+        /**
+         * @brief get the current lost to friction, signed to oppose the motion
+         *
+         * @param speed the speed of the motor
+         * @param drive the voltage or torque driving the motor, which gives the direction when the speed is 0
+         */
+        constexpr double friction(double speed, double drive) const {
+            return std::copysign(freeCurrent, speed != 0 ? speed : drive);
+        }
+
+        double resistance; /** winding resistance, in ohms */
+        double invResistance; /** reciprocal of the resistance */
+        double kT; /** torque constant, in Nm per amp */
+        double kE; /** back EMF constant, in volts per rad/s */
+        double freeCurrent; /** current lost to friction, in amps */
+};
+} // namespace units
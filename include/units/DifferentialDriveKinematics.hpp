@@ -0,0 +1,105 @@
+#pragma once
+
+#include "units/Pose.hpp"
+
+namespace units {
+/**
+ * @struct WheelSpeeds
+ *
+ * @brief the linear velocity of each side of a differential drive
+ */
+struct WheelSpeeds {
+        LinearVelocity left = LinearVelocity(0.0); /** left side velocity */
+        LinearVelocity right = LinearVelocity(0.0); /** right side velocity */
+};
+
+/**
+ * @class DifferentialDriveKinematics
+ *
+ * @brief converts between chassis velocities, wheel velocities, and motor velocities of a differential drive
+ *
+ * Chassis velocities are VelocityPoses in the frame of the robot, where x is forwards and orientation is the
+ * counterclockwise angular velocity. The y component is always 0, since a differential drive can't strafe.
+ *
+ * Every constant (reciprocal of the track width, wheel radius, gear ratio) is precomputed on construction, so
+ * conversions are multiplies only.
+ */
+class DifferentialDriveKinematics {
+    public:
+        /**
+         * @brief Construct a new DifferentialDriveKinematics object
+         *
+         * @param trackWidth the distance between the left and right wheels
+         * @param wheelDiameter the diameter of the wheels
+         * @param gearRatio wheel speed divided by motor speed, e.g 0.75 for a 600 rpm motor driving a 450 rpm wheel
+         */
+        constexpr DifferentialDriveKinematics(Length trackWidth, Length wheelDiameter, Number gearRatio = 1.0)
+            : halfTrackWidth(trackWidth.internal() / 2),
+              invTrackWidth(1.0 / trackWidth.internal()),
+              motorPerWheel(toAngular<LinearVelocity>(LinearVelocity(1.0), wheelDiameter).internal() /
+                            gearRatio.internal()),
+              wheelPerMotor(toLinear<AngularVelocity>(AngularVelocity(1.0), wheelDiameter).internal() *
+                            gearRatio.internal()) {}
+
+        /**
+         * @brief get the chassis velocity from the wheel velocities
+         *
+         * @param wheels the wheel velocities
+         * @return VelocityPose
+         */
+        constexpr VelocityPose toChassis(WheelSpeeds wheels) const {
+            return VelocityPose((wheels.left + wheels.right) * 0.5, LinearVelocity(0.0),
+                                AngularVelocity((wheels.right - wheels.left).internal() * invTrackWidth));
+        }
+
+        /**
+         * @brief get the wheel velocities from a chassis velocity
+         *
+         * @param chassis the chassis velocity. Its y component is ignored
+         * @return WheelSpeeds
+         */
+        constexpr WheelSpeeds toWheels(VelocityPose chassis) const {
+            const LinearVelocity turn = LinearVelocity(chassis.orientation.internal() * halfTrackWidth);
+            return {chassis.x - turn, chassis.x + turn};
+        }
+
+        /**
+         * @brief scale down wheel velocities so neither exceeds a maximum, keeping the ratio between them
+         *
+         * @param wheels the wheel velocities
+         * @param max the maximum velocity of a wheel
+         * @return WheelSpeeds
+         */
+        constexpr static WheelSpeeds desaturate(WheelSpeeds wheels, LinearVelocity max) {
+            const LinearVelocity fastest = units::max(abs(wheels.left), abs(wheels.right));
+            if (fastest <= max) return wheels;
+            const double scale = max.internal() / fastest.internal();
+            return {wheels.left * scale, wheels.right * scale};
+        }
+
+        /**
+         * @brief get the motor velocity needed for a wheel velocity
+         *
+         * @param wheel the wheel velocity
+         * @return AngularVelocity
+         */
+        constexpr AngularVelocity toMotor(LinearVelocity wheel) const {
+            return AngularVelocity(wheel.internal() * motorPerWheel);
+        }
+
+        /**
+         * @brief get the wheel velocity from a motor velocity
+         *
+         * @param motor the motor velocity
+         * @return LinearVelocity
+         */
+        constexpr LinearVelocity toWheel(AngularVelocity motor) const {
+            return LinearVelocity(motor.internal() * wheelPerMotor);
+        }
+    private:
+        double halfTrackWidth; /** half of the track width */
+        double invTrackWidth; /** reciprocal of the track width */
+        double motorPerWheel; /** motor rad/s per wheel m/s */
+        double wheelPerMotor; /** wheel m/s per motor rad/s */
+};
+} // namespace units
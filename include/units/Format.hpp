@@ -0,0 +1,55 @@
+#pragma once
+
+#include "units/units.hpp"
+#include <algorithm>
+#include <charconv>
+#include <system_error>
+
+namespace units {
+/**
+ * @brief write the suffix of a unit after its value
+ *
+ * @param value the result of writing the value
+ * @param end the end of the buffer
+ * @return std::to_chars_result
+ */
+template <isQuantity Q> std::to_chars_result appendSuffix(std::to_chars_result value, char* end) {
+    constexpr std::string_view suffix = UnitSuffix<Named<Q>>::value;
+    if (value.ec != std::errc()) return value;
+    if (static_cast<std::size_t>(end - value.ptr) < suffix.size()) return {end, std::errc::value_too_large};
+    return {std::copy(suffix.begin(), suffix.end(), value.ptr), std::errc()};
+}
+
+/**
+ * @brief write a quantity as text, e.g "1.5 m"
+ *
+ * The value is written with std::to_chars, in the shortest form that reads back exactly, followed by the suffix of
+ * the unit, which is chosen at compile time. Nothing is allocated, and the locale is ignored. Like std::to_chars, the
+ * text is not null terminated.
+ *
+ * @param buf the buffer to write to
+ * @param n the size of the buffer
+ * @param quantity the quantity to write
+ * @return std::to_chars_result ptr is one past the last character written. If the buffer is too small, ec is
+ * std::errc::value_too_large, and the contents of the buffer are unspecified
+ */
+template <isQuantity Q> std::to_chars_result format_to(char* buf, std::size_t n, Q quantity) {
+    return appendSuffix<Q>(std::to_chars(buf, buf + n, quantity.internal()), buf + n);
+}
+
+/**
+ * @brief write a quantity as text, with a given format and precision
+ *
+ * @param buf the buffer to write to
+ * @param n the size of the buffer
+ * @param quantity the quantity to write
+ * @param fmt the floating point format, e.g std::chars_format::fixed
+ * @param precision the precision, as for printf
+ * @return std::to_chars_result ptr is one past the last character written. If the buffer is too small, ec is
+ * std::errc::value_too_large, and the contents of the buffer are unspecified
+ */
+template <isQuantity Q>
+std::to_chars_result format_to(char* buf, std::size_t n, Q quantity, std::chars_format fmt, int precision) {
+    return appendSuffix<Q>(std::to_chars(buf, buf + n, quantity.internal(), fmt, precision), buf + n);
+}
+} // namespace units
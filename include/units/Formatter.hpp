@@ -0,0 +1,300 @@
+#pragma once
+
+#include "units/Parse.hpp"
+#include "units/Pose.hpp"
+#include "units/Vector2D.hpp"
+#include "units/Vector3D.hpp"
+#include <algorithm>
+#include <charconv>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <string_view>
+#include <system_error>
+#if __has_include(<format>)
+#include <format>
+#endif
+
+namespace units {
+/**
+ * @class QuantityFormatSpec
+ *
+ * @brief a parsed format spec for a quantity, which picks the precision and display unit, e.g ".2in" or "cDeg"
+ *
+ * The spec is [.precision][unit]. With a precision, the value is written in fixed point with that many digits after
+ * the decimal point, otherwise in the shortest form that reads back exactly. The unit is any suffix units::parse
+ * accepts, and is looked up when the spec is parsed, so that formatting is just a multiply, an add, and
+ * std::to_chars. Without a unit, the value is written in base units.
+ *
+ * Parsing is constexpr. std::format parses the spec of a format string that is known at compile time while compiling,
+ * so for those the unit lookup, and any error in the spec, happen at compile time. The lookup only happens at runtime
+ * for format strings that are only known at runtime, e.g with std::vformat, where the unit can't be known earlier.
+ *
+ * This is the implementation of the std::formatter specializations below, and is independent of <format>, so it can
+ * also be used by other formatting libraries.
+ *
+ * @tparam Q the quantity type to format
+ */
+template <isQuantity Q> class QuantityFormatSpec {
+    public:
+        /**
+         * @brief parse a spec
+         *
+         * Parsing stops at the end of the spec, or at a '}' or ','. Errors are reported through error()
+         *
+         * @param it the start of the spec
+         * @param end the end of the text the spec is in
+         * @return It where parsing stopped
+         */
+        template <typename It> constexpr It parse(It it, It end) {
+            if (it != end && *it == '.') {
+                ++it;
+                if (it == end || *it < '0' || *it > '9') {
+                    errorMessage = "expected a precision after '.'";
+                    return it;
+                }
+                precision = 0;
+                for (; it != end && *it >= '0' && *it <= '9'; ++it) precision = precision * 10 + (*it - '0');
+                if (precision > 17) {
+                    errorMessage = "the precision can't be more than 17";
+                    return it;
+                }
+            }
+            const It unitStart = it;
+            while (it != end && *it != '}' && *it != ',') ++it;
+            if (it == unitStart) return it;
+            const UnitParseEntry* unit = unitTable.find(std::string_view(std::to_address(unitStart), it - unitStart));
+            if (unit == nullptr) errorMessage = "unknown unit";
+            else if (unit->dimensions != dimensionsOf<Q>()) errorMessage = "the unit has the wrong dimensions";
+            else {
+                scale = unit->scale;
+                offset = unit->offset;
+                suffix = unit->suffix;
+                separator = " ";
+            }
+            return it;
+        }
+
+        /**
+         * @brief get the error from parsing the spec
+         *
+         * @return const char* nullptr if the spec is valid
+         */
+        constexpr const char* error() const { return errorMessage; }
+
+        /**
+         * @brief write a quantity as text, in the unit of the spec
+         *
+         * @param first the start of the buffer
+         * @param last the end of the buffer
+         * @param quantity the quantity to write
+         * @return std::to_chars_result as for units::format_to
+         */
+        std::to_chars_result write(char* first, char* last, Q quantity) const {
+            const double value = (quantity.internal() - offset) / scale;
+            std::to_chars_result result = precision < 0 ? std::to_chars(first, last, value)
+                                                        : std::to_chars(first, last, value, std::chars_format::fixed,
+                                                                        precision);
+            if (result.ec != std::errc()) return result;
+            for (std::string_view text : {separator, suffix}) {
+                if (static_cast<std::size_t>(last - result.ptr) < text.size()) {
+                    return {last, std::errc::value_too_large};
+                }
+                result.ptr = std::copy(text.begin(), text.end(), result.ptr);
+            }
+            return result;
+        }
+
+        /**
+         * @brief write a quantity to an output iterator, in the unit of the spec
+         *
+         * Only the number goes through a stack buffer, which fits any double, so nothing is ever truncated. The suffix
+         * is copied straight to the output
+         *
+         * @param out the output iterator
+         * @param quantity the quantity to write
+         * @return Out the output iterator, after the text
+         */
+        template <typename Out> Out write(Out out, Q quantity) const {
+            char buffer[maxNumberLength];
+            const double value = (quantity.internal() - offset) / scale;
+            const std::to_chars_result result = precision < 0 ? std::to_chars(buffer, std::end(buffer), value)
+                                                              : std::to_chars(buffer, std::end(buffer), value,
+                                                                              std::chars_format::fixed, precision);
+            out = std::copy(buffer, result.ptr, out);
+            out = std::copy(separator.begin(), separator.end(), out);
+            return std::copy(suffix.begin(), suffix.end(), out);
+        }
+
+        /**
+         * @brief write a vector to an output iterator as (x, y), in the unit of the spec
+         *
+         * @param out the output iterator
+         * @param vector the vector to write
+         * @return Out the output iterator, after the text
+         */
+        template <typename Out> Out write(Out out, const Vector2D<Q>& vector) const {
+            *out++ = '(';
+            out = write(out, vector.x);
+            out = std::copy_n(", ", 2, out);
+            out = write(out, vector.y);
+            *out++ = ')';
+            return out;
+        }
+
+        /**
+         * @brief write a vector to an output iterator as (x, y, z), in the unit of the spec
+         *
+         * @param out the output iterator
+         * @param vector the vector to write
+         * @return Out the output iterator, after the text
+         */
+        template <typename Out> Out write(Out out, const Vector3D<Q>& vector) const {
+            *out++ = '(';
+            out = write(out, vector.x);
+            out = std::copy_n(", ", 2, out);
+            out = write(out, vector.y);
+            out = std::copy_n(", ", 2, out);
+            out = write(out, vector.z);
+            *out++ = ')';
+            return out;
+        }
+    private:
+        // the longest number: a sign, the 309 digits of the largest double, a '.', and 17 digits after it
+        static constexpr std::size_t maxNumberLength = 1 + std::numeric_limits<double>::max_exponent10 + 1 + 1 + 17;
+
+        const char* errorMessage = nullptr;
+        int precision = -1; /** -1 for the shortest representation */
+        double scale = 1;
+        double offset = 0;
+        std::string_view separator = ""; /** between the value and the suffix */
+        std::string_view suffix = UnitSuffix<Named<Q>>::value;
+};
+
+/**
+ * @class PoseFormatSpec
+ *
+ * @brief a parsed format spec for a pose, e.g ".1in,deg"
+ *
+ * The spec is a QuantityFormatSpec for the position, optionally followed by a ',' and a QuantityFormatSpec for the
+ * orientation. Like QuantityFormatSpec, it is independent of <format>.
+ *
+ * @tparam derivatives the derivatives of the pose, as for AbstractPose
+ */
+template <typename derivatives> class PoseFormatSpec {
+    public:
+        /**
+         * @brief parse a spec
+         *
+         * Parsing stops at the end of the spec, or at a '}'. Errors are reported through error()
+         *
+         * @param it the start of the spec
+         * @param end the end of the text the spec is in
+         * @return It where parsing stopped
+         */
+        template <typename It> constexpr It parse(It it, It end) {
+            it = position.parse(it, end);
+            if (position.error() != nullptr) return it;
+            if (it != end && *it == ',') it = orientation.parse(++it, end);
+            return it;
+        }
+
+        /**
+         * @brief get the error from parsing the spec
+         *
+         * @return const char* nullptr if the spec is valid
+         */
+        constexpr const char* error() const {
+            return position.error() != nullptr ? position.error() : orientation.error();
+        }
+
+        /**
+         * @brief write a pose to an output iterator as (x, y, orientation), in the units of the spec
+         *
+         * @param out the output iterator
+         * @param pose the pose to write
+         * @return Out the output iterator, after the text
+         */
+        template <typename Out> Out write(Out out, const AbstractPose<derivatives>& pose) const {
+            *out++ = '(';
+            out = position.write(out, pose.x);
+            out = std::copy_n(", ", 2, out);
+            out = position.write(out, pose.y);
+            out = std::copy_n(", ", 2, out);
+            out = orientation.write(out, pose.orientation);
+            *out++ = ')';
+            return out;
+        }
+    private:
+        QuantityFormatSpec<Divided<Length, Exponentiated<Time, derivatives>>> position;
+        QuantityFormatSpec<Divided<Angle, Exponentiated<Time, derivatives>>> orientation;
+};
+} // namespace units
+
+#ifdef __cpp_lib_format
+// std::format support
+// Quantities, vectors, and poses can be formatted with std::format, std::format_to, and std::format_to_n. The format
+// spec is described by units::QuantityFormatSpec and units::PoseFormatSpec, and is checked at compile time, so an
+// unknown unit or a unit with the wrong dimensions is a compile error.
+// - quantities: "{:.2in}" -> "12.00 in"
+// - vectors: "{:.1in}" -> "(12.0 in, 3.5 in)". The spec applies to every component
+// - poses: "{:.1in,deg}" -> "(12.0 in, 3.5 in, 90 deg)". The spec after the ',' applies to the orientation
+// The specializations only forward to the spec classes, which hold all of the parsing and formatting.
+
+namespace units {
+/**
+ * @brief parse the spec of a std::formatter, and throw std::format_error if it's invalid
+ */
+template <typename Spec> constexpr auto parseFormatSpec(Spec& spec, std::format_parse_context& ctx) {
+    auto it = spec.parse(ctx.begin(), ctx.end());
+    if (spec.error() != nullptr) throw std::format_error(spec.error());
+    if (it != ctx.end() && *it != '}') throw std::format_error("invalid format spec");
+    return it;
+}
+} // namespace units
+
+/**
+ * @brief formats a quantity
+ */
+template <isQuantity Q> struct std::formatter<Q, char> {
+        units::QuantityFormatSpec<Q> spec;
+
+        constexpr auto parse(std::format_parse_context& ctx) { return units::parseFormatSpec(spec, ctx); }
+
+        template <typename FormatContext> auto format(Q quantity, FormatContext& ctx) const {
+            return spec.write(ctx.out(), quantity);
+        }
+};
+
+/**
+ * @brief formats a Vector2D as (x, y)
+ */
+template <isQuantity T> struct std::formatter<units::Vector2D<T>, char> : std::formatter<T, char> {
+        template <typename FormatContext> auto format(const units::Vector2D<T>& vector, FormatContext& ctx) const {
+            return this->spec.write(ctx.out(), vector);
+        }
+};
+
+/**
+ * @brief formats a Vector3D as (x, y, z)
+ */
+template <isQuantity T> struct std::formatter<units::Vector3D<T>, char> : std::formatter<T, char> {
+        template <typename FormatContext> auto format(const units::Vector3D<T>& vector, FormatContext& ctx) const {
+            return this->spec.write(ctx.out(), vector);
+        }
+};
+
+/**
+ * @brief formats a pose as (x, y, orientation)
+ */
+template <typename derivatives> struct std::formatter<units::AbstractPose<derivatives>, char> {
+        units::PoseFormatSpec<derivatives> spec;
+
+        constexpr auto parse(std::format_parse_context& ctx) { return units::parseFormatSpec(spec, ctx); }
+
+        template <typename FormatContext>
+        auto format(const units::AbstractPose<derivatives>& pose, FormatContext& ctx) const {
+            return spec.write(ctx.out(), pose);
+        }
+};
+#endif
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "pros/error.h"
+#include "pros/gps.hpp"
+#include "units/Pose.hpp"
+
+namespace units {
+/**
+ * @struct GpsSnapshot
+ *
+ * @brief every reading of a GPS, taken at the same time
+ */
+struct GpsSnapshot {
+        Pose pose; /** pose of the robot, in the field frame */
+        Length error = Length(0.0); /** RMS error of the position reported by the GPS */
+};
+
+/**
+ * @class GpsAdapter
+ *
+ * @brief a typed view of a pros::Gps
+ *
+ * The GPS reports the position of the sensor in meters, and its heading as a compass angle in degrees. This adapter
+ * converts that into the pose of the robot in our field frame, in standard orientation.
+ *
+ * The compass to standard conversion, the mounting offset of the sensor, and the offset between the GPS field frame
+ * and our field frame are folded into one transform on construction. Converting a reading costs one sin and cos.
+ *
+ * The mounting offset is applied here, so don't also set it on the pros::Gps with set_offset().
+ */
+class GpsAdapter {
+    public:
+        /**
+         * @brief Construct a new GpsAdapter object
+         *
+         * @param gps the GPS to read from. Must outlive the adapter
+         * @param mount pose of the sensor relative to the tracking center of the robot, where x is forwards and the
+         * orientation is the direction the sensor faces
+         * @param field pose of the GPS field frame in our field frame. Defaults to the same frame
+         */
+        GpsAdapter(const pros::Gps& gps, Pose mount = Pose(), Pose field = Pose())
+            : gps(gps),
+              mountX(mount.x.internal()),
+              mountY(mount.y.internal()),
+              fieldX(field.x.internal()),
+              fieldY(field.y.internal()),
+              fieldCos(std::cos(field.orientation.internal())),
+              fieldSin(std::sin(field.orientation.internal())),
+              thetaOffset(M_PI_2 + field.orientation.internal() - mount.orientation.internal()) {}
+
+        /**
+         * @brief convert a raw GPS reading to the pose of the robot in our field frame
+         *
+         * @param status the raw reading
+         * @return Pose
+         */
+        Pose toPose(const pros::gps_status_s_t& status) const {
+            const double theta = thetaOffset - status.yaw * deg.internal();
+            const double c = std::cos(theta);
+            const double s = std::sin(theta);
+            const double x = fieldX + fieldCos * status.x - fieldSin * status.y - (c * mountX - s * mountY);
+            const double y = fieldY + fieldSin * status.x + fieldCos * status.y - (s * mountX + c * mountY);
+            return Pose(Length(x), Length(y), Angle(theta));
+        }
+
+        /**
+         * @brief read the pose and error of the GPS
+         *
+         * Makes one SDK call for each. If a read fails, the previous value is kept.
+         *
+         * @return const GpsSnapshot& the new snapshot
+         */
+        const GpsSnapshot& update() {
+            const pros::gps_status_s_t status = gps.get_position_and_orientation();
+            if (status.x != PROS_ERR_F) current.pose = toPose(status);
+            const double error = gps.get_error();
+            if (error != PROS_ERR_F) current.error = Length(error);
+            return current;
+        }
+
+        /**
+         * @brief get the latest snapshot
+         *
+         * @return const GpsSnapshot&
+         */
+        const GpsSnapshot& snapshot() const { return current; }
+
+        /**
+         * @brief get the pose of the robot from the latest snapshot
+         *
+         * @return Pose
+         */
+        Pose pose() const { return current.pose; }
+
+        /**
+         * @brief get the error of the GPS from the latest snapshot
+         *
+         * @return Length
+         */
+        Length error() const { return current.error; }
+    private:
+        const pros::Gps& gps;
+        // precomputed transform
+        double mountX; /** sensor position relative to the robot, in meters */
+        double mountY;
+        double fieldX; /** GPS field origin in our field frame, in meters */
+        double fieldY;
+        double fieldCos; /** rotation of the GPS field frame in our field frame */
+        double fieldSin;
+        double thetaOffset; /** added to the clockwise GPS heading to get the robot heading, in radians */
+        GpsSnapshot current;
+};
+} // namespace units
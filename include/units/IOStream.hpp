@@ -0,0 +1,20 @@
+#pragma once
+
+#include "units/units.hpp"
+#include <ostream>
+
+// iostream support
+// units.hpp doesn't include <iostream>, so that programs that never print quantities don't pay for the iostream static
+// initializers and code. Include this header to print quantities with std::ostream, or use units::format_to from
+// Format.hpp to format them into a buffer without iostream.
+
+/**
+ * @brief << operator overload. Prints the value of a quantity, followed by its unit
+ *
+ * @param os the stream to print to
+ * @param quantity the quantity to print
+ * @return std::ostream&
+ */
+template <isQuantity Q> inline std::ostream& operator<<(std::ostream& os, const Q& quantity) {
+    return os << quantity.internal() << UnitSuffix<Named<Q>>::value;
+}
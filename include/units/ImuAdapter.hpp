@@ -0,0 +1,130 @@
+#pragma once
+
+#include "pros/error.h"
+#include "pros/imu.hpp"
+#include "units/Quaternion.hpp"
+
+namespace units {
+/**
+ * @struct ImuSnapshot
+ *
+ * @brief every reading of an IMU, taken at the same time
+ *
+ * Angles follow standard orientation: counterclockwise is positive. The gyro and accelerometer readings are in the
+ * frame of the sensor, except that the z rate is negated like the rotation, so turning counterclockwise is positive.
+ */
+struct ImuSnapshot {
+        Angle heading = Angle(0.0); /** rotation wrapped to [0, 360) degrees */
+        Angle rotation = Angle(0.0); /** unwrapped, continuous rotation */
+        Vector3D<AngularVelocity> gyro; /** angular velocity around each axis */
+        Vector3D<LinearAcceleration> accel; /** linear acceleration along each axis */
+        Quaternion orientation; /** orientation, only updated if requested */
+};
+
+/**
+ * @class ImuAdapter
+ *
+ * @brief a typed view of a pros::Imu
+ *
+ * The IMU reports angles and the z rate in clockwise degrees, angular velocity in degrees per second, and acceleration
+ * in g. The conversion factors are folded into constants at compile time, so converting a reading is a single multiply.
+ *
+ * update() reads every field once, and stores them in a snapshot. The accessors return the latest snapshot, so the
+ * rest of a tick can read any field without calling into the SDK again. The heading is derived from the rotation
+ * instead of being read separately. If a read fails, the previous value of that field is kept.
+ */
+class ImuAdapter {
+    public:
+        /**
+         * @brief Construct a new ImuAdapter object
+         *
+         * @param imu the IMU to read from. Must outlive the adapter
+         * @param readOrientation whether update() should also read the orientation quaternion
+         */
+        ImuAdapter(const pros::Imu& imu, bool readOrientation = false)
+            : imu(imu),
+              readOrientation(readOrientation) {}
+
+        /**
+         * @brief read every field of the IMU
+         *
+         * @return const ImuSnapshot& the new snapshot
+         */
+        const ImuSnapshot& update() {
+            const double rotation = imu.get_rotation();
+            if (rotation != PROS_ERR_F) {
+                current.rotation = Angle(rotation * clockwiseDegree);
+                // fmod keeps the sign of the rotation, so a clockwise rotation gives a negative remainder
+                current.heading = constrainAngle360(current.rotation);
+                if (current.heading < Angle(0.0)) current.heading += rot;
+            }
+            const pros::imu_gyro_s_t gyro = imu.get_gyro_rate();
+            if (gyro.x != PROS_ERR_F) {
+                current.gyro = Vector3D<AngularVelocity>(AngularVelocity(gyro.x * degreePerSecond),
+                                                         AngularVelocity(gyro.y * degreePerSecond),
+                                                         AngularVelocity(gyro.z * clockwiseDegreePerSecond));
+            }
+            const pros::imu_accel_s_t accel = imu.get_accel();
+            if (accel.x != PROS_ERR_F) {
+                current.accel = Vector3D<LinearAcceleration>(LinearAcceleration(accel.x * standardGravity),
+                                                             LinearAcceleration(accel.y * standardGravity),
+                                                             LinearAcceleration(accel.z * standardGravity));
+            }
+            if (readOrientation) {
+                const pros::quaternion_s_t q = imu.get_quaternion();
+                if (q.w != PROS_ERR_F) current.orientation = Quaternion(q.w, q.x, q.y, q.z);
+            }
+            return current;
+        }
+
+        /**
+         * @brief get the latest snapshot
+         *
+         * @return const ImuSnapshot&
+         */
+        const ImuSnapshot& snapshot() const { return current; }
+
+        /**
+         * @brief get the heading from the latest snapshot
+         *
+         * @return Angle
+         */
+        Angle heading() const { return current.heading; }
+
+        /**
+         * @brief get the unwrapped rotation from the latest snapshot
+         *
+         * @return Angle
+         */
+        Angle rotation() const { return current.rotation; }
+
+        /**
+         * @brief get the angular velocity from the latest snapshot
+         *
+         * @return Vector3D<AngularVelocity>
+         */
+        Vector3D<AngularVelocity> gyro() const { return current.gyro; }
+
+        /**
+         * @brief get the linear acceleration from the latest snapshot
+         *
+         * @return Vector3D<LinearAcceleration>
+         */
+        Vector3D<LinearAcceleration> accel() const { return current.accel; }
+
+        /**
+         * @brief get the orientation from the latest snapshot
+         *
+         * @return Quaternion
+         */
+        Quaternion orientation() const { return current.orientation; }
+    private:
+        static constexpr double clockwiseDegree = -deg.internal(); /** clockwise degrees to rad */
+        static constexpr double degreePerSecond = (deg / sec).internal(); /** degrees per second to rad/s */
+        static constexpr double clockwiseDegreePerSecond = -degreePerSecond; /** clockwise deg/s to rad/s */
+        static constexpr double standardGravity = 9.80665; /** g to m/s^2 */
+        const pros::Imu& imu;
+        bool readOrientation;
+        ImuSnapshot current;
+};
+} // namespace units
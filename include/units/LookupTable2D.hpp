@@ -0,0 +1,208 @@
+#pragma once
+
+#include "units/units.hpp"
+
+namespace units {
+/**
+ * @brief the last cell a LookupTable2D query landed in
+ *
+ * Queries that move slowly (e.g one per control loop iteration) almost always land in the same cell as the previous
+ * query, or a neighbouring one. Passing the same hint to consecutive queries lets the table skip the binary search.
+ */
+struct LookupHint {
+        std::size_t x = 0; /** x index of the last cell */
+        std::size_t y = 0; /** y index of the last cell */
+};
+
+/**
+ * @class LookupTable2D
+ *
+ * @brief a 2D table of Z values, sampled over a grid of X and Y breakpoints
+ *
+ * The grid can either be uniform (evenly spaced breakpoints, cell lookup is a single multiply) or rectilinear
+ * (arbitrary increasing breakpoints, cell lookup is a hinted search). Queries outside of the grid are clamped to its
+ * edges.
+ *
+ * @tparam X the quantity type of the first axis
+ * @tparam Y the quantity type of the second axis
+ * @tparam Z the quantity type stored in the table
+ * @tparam NX the number of breakpoints on the X axis
+ * @tparam NY the number of breakpoints on the Y axis
+ */
+template <isQuantity X, isQuantity Y, isQuantity Z, std::size_t NX, std::size_t NY> class LookupTable2D {
+        static_assert(NX >= 2 && NY >= 2, "LookupTable2D needs at least 2 breakpoints on each axis");
+    public:
+        /**
+         * @brief Construct a new rectilinear LookupTable2D object
+         *
+         * @param xs the X breakpoints, strictly increasing
+         * @param ys the Y breakpoints, strictly increasing
+         * @param values the table values, indexed as values[x][y]
+         */
+        constexpr LookupTable2D(const std::array<X, NX>& xs, const std::array<Y, NY>& ys,
+                                const std::array<std::array<Z, NY>, NX>& values)
+            : xs(), ys(), zs(), invDx(0), invDy(0) {
+            for (std::size_t i = 0; i < NX; i++) this->xs[i] = xs[i].internal();
+            for (std::size_t j = 0; j < NY; j++) this->ys[j] = ys[j].internal();
+            for (std::size_t i = 0; i < NX; i++)
+                for (std::size_t j = 0; j < NY; j++) zs[i * NY + j] = values[i][j].internal();
+        }
+
+        /**
+         * @brief Create a new LookupTable2D object with evenly spaced breakpoints
+         *
+         * @param xMin the first X breakpoint
+         * @param xMax the last X breakpoint
+         * @param yMin the first Y breakpoint
+         * @param yMax the last Y breakpoint
+         * @param values the table values, indexed as values[x][y]
+         * @return LookupTable2D
+         */
+        constexpr static LookupTable2D uniform(X xMin, X xMax, Y yMin, Y yMax,
+                                               const std::array<std::array<Z, NY>, NX>& values) {
+            LookupTable2D table(values);
+            const double dx = (xMax - xMin).internal() / (NX - 1);
+            const double dy = (yMax - yMin).internal() / (NY - 1);
+            for (std::size_t i = 0; i < NX; i++) table.xs[i] = xMin.internal() + dx * i;
+            for (std::size_t j = 0; j < NY; j++) table.ys[j] = yMin.internal() + dy * j;
+            table.invDx = 1.0 / dx;
+            table.invDy = 1.0 / dy;
+            return table;
+        }
+
+        /**
+         * @brief get the value stored at a breakpoint
+         *
+         * @param i X index
+         * @param j Y index
+         * @return Z
+         */
+        constexpr Z at(std::size_t i, std::size_t j) const { return Z(zs[i * NY + j]); }
+
+        /**
+         * @brief bilinearly interpolate the table
+         *
+         * @param x X coordinate
+         * @param y Y coordinate
+         * @return Z
+         */
+        constexpr Z bilinear(X x, Y y) const {
+            LookupHint hint;
+            return bilinear(x, y, hint);
+        }
+
+        /**
+         * @brief bilinearly interpolate the table, starting the cell search from a hint
+         *
+         * @param x X coordinate
+         * @param y Y coordinate
+         * @param hint the cell of the previous query, updated to the cell of this query
+         * @return Z
+         */
+        constexpr Z bilinear(X x, Y y, LookupHint& hint) const {
+            const double tx = locate(xs, invDx, x.internal(), hint.x);
+            const double ty = locate(ys, invDy, y.internal(), hint.y);
+            const double* row0 = &zs[hint.x * NY + hint.y];
+            const double* row1 = row0 + NY;
+            const double z0 = row0[0] + (row0[1] - row0[0]) * ty;
+            const double z1 = row1[0] + (row1[1] - row1[0]) * ty;
+            return Z(z0 + (z1 - z0) * tx);
+        }
+
+        /**
+         * @brief bicubically interpolate the table
+         *
+         * Uses cubic hermite splines with finite difference slopes along both axes, so the result is smooth across
+         * cell boundaries and passes through every breakpoint
+         *
+         * @param x X coordinate
+         * @param y Y coordinate
+         * @return Z
+         */
+        constexpr Z bicubic(X x, Y y) const {
+            LookupHint hint;
+            return bicubic(x, y, hint);
+        }
+
+        /**
+         * @brief bicubically interpolate the table, starting the cell search from a hint
+         *
+         * @param x X coordinate
+         * @param y Y coordinate
+         * @param hint the cell of the previous query, updated to the cell of this query
+         * @return Z
+         */
+        constexpr Z bicubic(X x, Y y, LookupHint& hint) const {
+            const double tx = locate(xs, invDx, x.internal(), hint.x);
+            const double ty = locate(ys, invDy, y.internal(), hint.y);
+            // neighbouring breakpoints, clamped to the table. A clamped neighbour results in a one sided slope
+            const std::size_t i[4] = {hint.x == 0 ? 0 : hint.x - 1, hint.x, hint.x + 1,
+                                      hint.x + 2 < NX ? hint.x + 2 : NX - 1};
+            const std::size_t j[4] = {hint.y == 0 ? 0 : hint.y - 1, hint.y, hint.y + 1,
+                                      hint.y + 2 < NY ? hint.y + 2 : NY - 1};
+            double column[4];
+            for (std::size_t k = 0; k < 4; k++) {
+                const double* row = &zs[i[k] * NY];
+                column[k] = hermite(ys[j[0]], ys[j[1]], ys[j[2]], ys[j[3]], row[j[0]], row[j[1]], row[j[2]], row[j[3]],
+                                    ty);
+            }
+            return Z(hermite(xs[i[0]], xs[i[1]], xs[i[2]], xs[i[3]], column[0], column[1], column[2], column[3], tx));
+        }
+    private:
+        std::array<double, NX> xs; /** X breakpoints, in base units */
+        std::array<double, NY> ys; /** Y breakpoints, in base units */
+        std::array<double, NX * NY> zs; /** values in base units, row major */
+        double invDx; /** reciprocal of the X spacing, or 0 if the X axis isn't uniform */
+        double invDy; /** reciprocal of the Y spacing, or 0 if the Y axis isn't uniform */
+
+        constexpr LookupTable2D(const std::array<std::array<Z, NY>, NX>& values)
+            : xs(), ys(), zs(), invDx(0), invDy(0) {
+            for (std::size_t i = 0; i < NX; i++)
+                for (std::size_t j = 0; j < NY; j++) zs[i * NY + j] = values[i][j].internal();
+        }
+
+        /**
+         * @brief find the cell containing a value along one axis
+         *
+         * @param bp the axis breakpoints
+         * @param inv the reciprocal of the axis spacing, or 0 if the axis isn't uniform
+         * @param v the value to find
+         * @param cell the cell to start the search from, updated to the cell containing v
+         * @return double the position of v within its cell, from 0 to 1
+         */
+        template <std::size_t N>
+        constexpr static double locate(const std::array<double, N>& bp, double inv, double v, std::size_t& cell) {
+            v = std::clamp(v, bp[0], bp[N - 1]);
+            if (inv != 0) {
+                cell = std::min(static_cast<std::size_t>((v - bp[0]) * inv), N - 2);
+            } else {
+                std::size_t c = std::min(cell, N - 2);
+                // slowly moving queries stay in the same cell or step into a neighbour
+                if (v < bp[c]) {
+                    if (c > 0 && v >= bp[c - 1]) c--;
+                    else c = std::upper_bound(bp.begin() + 1, bp.begin() + c, v) - bp.begin() - 1;
+                } else if (v >= bp[c + 1]) {
+                    if (c + 2 < N && v < bp[c + 2]) c++;
+                    else c = std::upper_bound(bp.begin() + c + 1, bp.end() - 1, v) - bp.begin() - 1;
+                }
+                cell = c;
+            }
+            return std::clamp((v - bp[cell]) / (bp[cell + 1] - bp[cell]), 0.0, 1.0);
+        }
+
+        /**
+         * @brief cubic hermite interpolation between p1 and p2
+         *
+         * @return double the interpolated value at t, where t = 0 is p1 and t = 1 is p2
+         */
+        constexpr static double hermite(double x0, double x1, double x2, double x3, double p0, double p1, double p2,
+                                        double p3, double t) {
+            const double h = x2 - x1;
+            const double m1 = (p2 - p0) / (x2 - x0) * h;
+            const double m2 = (p3 - p1) / (x3 - x1) * h;
+            const double t2 = t * t;
+            const double t3 = t2 * t;
+            return (2 * t3 - 3 * t2 + 1) * p1 + (t3 - 2 * t2 + t) * m1 + (3 * t2 - 2 * t3) * p2 + (t3 - t2) * m2;
+        }
+};
+} // namespace units
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "units/units.hpp"
+
+namespace units {
+/**
+ * @struct MotionState
+ *
+ * @brief the position, velocity, and acceleration of a 1D motion at a point in time
+ *
+ * @tparam Q the position quantity type, e.g Length or Angle
+ */
+template <isQuantity Q> struct MotionState {
+        using Velocity = Divided<Q, Time>;
+        using Acceleration = Divided<Velocity, Time>;
+
+        Q position = Q(0.0); /** position */
+        Velocity velocity = Velocity(0.0); /** velocity */
+        Acceleration acceleration = Acceleration(0.0); /** acceleration */
+};
+} // namespace units
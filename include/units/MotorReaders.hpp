@@ -0,0 +1,181 @@
+#pragma once
+
+#include "pros/motor_group.hpp"
+#include "units/Angle.hpp"
+#include "units/Temperature.hpp"
+#include <array>
+#include <span>
+
+namespace units {
+// Typed readers for pros::MotorGroup
+// Unlike the get_*_all() functions of pros::MotorGroup, which return a newly allocated std::vector, these write into a
+// buffer provided by the caller (e.g a std::array), and never touch the heap. Each reader reads up to the size of the
+// buffer, and returns how many motors were read. Positions read every tick should be read with a PositionReader, which
+// caches the conversion from encoder units.
+
+/**
+ * @brief convert a motor position in encoder units to an Angle
+ *
+ * @param position the position, in the given encoder units
+ * @param encoderUnits the encoder units of the motor
+ * @param gears the cartridge of the motor, used if the encoder units are counts
+ * @return Angle
+ */
+constexpr Angle fromEncoderUnits(double position, pros::MotorUnits encoderUnits, pros::MotorGears gears) {
+    switch (encoderUnits) {
+        case pros::MotorUnits::degrees: return position * deg;
+        case pros::MotorUnits::rotations: return position * rot;
+        case pros::MotorUnits::counts:
+            if (gears == pros::MotorGears::red) return position / 1800 * rot;
+            if (gears == pros::MotorGears::green) return position / 900 * rot;
+            return position / 300 * rot;
+        default: return Angle(0.0);
+    }
+}
+
+/**
+ * @brief the number of motors a reader will read
+ */
+inline std::size_t readCount(const pros::MotorGroup& group, std::size_t capacity) {
+    return std::min(static_cast<std::size_t>(std::max<std::int8_t>(group.size(), 0)), capacity);
+}
+
+/**
+ * @class PositionReader
+ *
+ * @brief reads the position of each motor in a group
+ *
+ * Converting a position to an Angle needs the encoder units and cartridge of the motor, which only change when the
+ * program sets them. They are read once on construction, and again on refresh(), so each read is 1 call per motor.
+ *
+ * @tparam MaxMotors the maximum number of motors read
+ */
+template <std::size_t MaxMotors = 8> class PositionReader {
+    public:
+        /**
+         * @brief Construct a new PositionReader object
+         *
+         * @param group the motor group. Must outlive the reader
+         */
+        PositionReader(const pros::MotorGroup& group) : group(group) { refresh(); }
+
+        /**
+         * @brief read the encoder units and cartridge of each motor again, e.g after they were changed
+         */
+        void refresh() {
+            count = readCount(group, MaxMotors);
+            for (std::uint8_t i = 0; i < count; i++) {
+                scales[i] = fromEncoderUnits(1, group.get_encoder_units(i), group.get_gearing(i)).internal();
+            }
+        }
+
+        /**
+         * @brief read the position of each motor
+         *
+         * @param out buffer for the positions
+         * @return std::size_t the number of positions read
+         */
+        std::size_t read(std::span<Angle> out) const {
+            const std::size_t n = std::min(count, out.size());
+            for (std::uint8_t i = 0; i < n; i++) out[i] = Angle(group.get_position(i) * scales[i]);
+            return n;
+        }
+    private:
+        const pros::MotorGroup& group;
+        std::array<double, MaxMotors> scales {}; /** rad per encoder unit of each motor */
+        std::size_t count = 0; /** number of motors read */
+};
+
+/**
+ * @brief read the position of each motor in a group
+ *
+ * This reads the encoder units and cartridge of each motor too, so it makes 3 calls per motor. Use a PositionReader to
+ * read positions every tick
+ *
+ * @param group the motor group
+ * @param out buffer for the positions
+ * @return std::size_t the number of positions read
+ */
+inline std::size_t readPositions(const pros::MotorGroup& group, std::span<Angle> out) {
+    // the brain has 21 ports, so no group has more motors
+    return PositionReader<21>(group).read(out);
+}
+
+/**
+ * @brief read the velocity of each motor in a group
+ *
+ * @param group the motor group
+ * @param out buffer for the velocities
+ * @return std::size_t the number of velocities read
+ */
+inline std::size_t readVelocities(const pros::MotorGroup& group, std::span<AngularVelocity> out) {
+    const std::size_t n = readCount(group, out.size());
+    for (std::uint8_t i = 0; i < n; i++) out[i] = group.get_actual_velocity(i) * rpm;
+    return n;
+}
+
+/**
+ * @brief read the current drawn by each motor in a group
+ *
+ * @param group the motor group
+ * @param out buffer for the currents
+ * @return std::size_t the number of currents read
+ */
+inline std::size_t readCurrents(const pros::MotorGroup& group, std::span<Current> out) {
+    const std::size_t n = readCount(group, out.size());
+    for (std::uint8_t i = 0; i < n; i++) out[i] = Current(group.get_current_draw(i) / 1000.0);
+    return n;
+}
+
+/**
+ * @brief read the voltage applied to each motor in a group
+ *
+ * @param group the motor group
+ * @param out buffer for the voltages
+ * @return std::size_t the number of voltages read
+ */
+inline std::size_t readVoltages(const pros::MotorGroup& group, std::span<Voltage> out) {
+    const std::size_t n = readCount(group, out.size());
+    for (std::uint8_t i = 0; i < n; i++) out[i] = Voltage(group.get_voltage(i) / 1000.0);
+    return n;
+}
+
+/**
+ * @brief read the temperature of each motor in a group
+ *
+ * @param group the motor group
+ * @param out buffer for the temperatures
+ * @return std::size_t the number of temperatures read
+ */
+inline std::size_t readTemperatures(const pros::MotorGroup& group, std::span<Temperature> out) {
+    const std::size_t n = readCount(group, out.size());
+    for (std::uint8_t i = 0; i < n; i++) out[i] = from_celsius(group.get_temperature(i));
+    return n;
+}
+
+/**
+ * @brief read the torque produced by each motor in a group
+ *
+ * @param group the motor group
+ * @param out buffer for the torques
+ * @return std::size_t the number of torques read
+ */
+inline std::size_t readTorques(const pros::MotorGroup& group, std::span<Torque> out) {
+    const std::size_t n = readCount(group, out.size());
+    for (std::uint8_t i = 0; i < n; i++) out[i] = Torque(group.get_torque(i));
+    return n;
+}
+
+/**
+ * @brief read the power drawn by each motor in a group
+ *
+ * @param group the motor group
+ * @param out buffer for the powers
+ * @return std::size_t the number of powers read
+ */
+inline std::size_t readPowers(const pros::MotorGroup& group, std::span<Power> out) {
+    const std::size_t n = readCount(group, out.size());
+    for (std::uint8_t i = 0; i < n; i++) out[i] = Power(group.get_power(i));
+    return n;
+}
+} // namespace units
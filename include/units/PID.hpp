@@ -0,0 +1,120 @@
+#pragma once
+
+#include "units/units.hpp"
+#include <limits>
+
+namespace units {
+/**
+ * @brief how a PID controller stops its integral from winding up while its output is saturated
+ */
+enum class AntiWindup {
+    None, /** always integrate */
+    Clamping, /** stop integrating while the output is saturated in the direction of the error */
+    BackCalculation, /** bleed the integral by how far the output is saturated */
+};
+
+/**
+ * @class PID
+ *
+ * @brief a typed PID controller running at a fixed sample period
+ *
+ * The gains and the sample period are folded into the coefficients of a difference equation on construction, so an
+ * update is a handful of multiply-adds with no division by the time step. The derivative is taken on the error, and can
+ * be low pass filtered.
+ *
+ * @tparam Error the quantity type of the error, e.g Length
+ * @tparam Output the quantity type of the output, e.g Voltage
+ */
+template <isQuantity Error, isQuantity Output> class PID {
+    public:
+        using Proportional = Divided<Output, Error>;
+        using Integral = Divided<Output, Multiplied<Error, Time>>;
+        using Derivative = Divided<Output, Divided<Error, Time>>;
+
+        /**
+         * @brief Construct a new PID object
+         *
+         * @param kP proportional gain
+         * @param kI integral gain
+         * @param kD derivative gain
+         * @param period the time between updates
+         * @param derivativeFilter time constant of the derivative low pass filter. 0 disables filtering
+         */
+        constexpr PID(Proportional kP, Integral kI, Derivative kD, Time period, Time derivativeFilter = Time(0.0))
+            : dt(period.internal()),
+              cP(kP.internal()),
+              cI(kI.internal() * dt),
+              cDA(derivativeFilter.internal() / (derivativeFilter.internal() + dt)),
+              cDB(kD.internal() / (derivativeFilter.internal() + dt)) {}
+
+        /**
+         * @brief limit the output of the controller
+         *
+         * @param min the minimum output
+         * @param max the maximum output
+         * @param mode how to stop the integral from winding up while the output is limited
+         * @param trackingTime time constant of back calculation, how quickly the integral is bled. Defaults to the
+         * sample period
+         */
+        constexpr void setOutputLimits(Output min, Output max, AntiWindup mode = AntiWindup::Clamping,
+                                       Time trackingTime = Time(0.0)) {
+            outMin = min.internal();
+            outMax = max.internal();
+            antiWindup = mode;
+            cB = trackingTime.internal() > 0 ? dt / trackingTime.internal() : 1;
+        }
+
+        /**
+         * @brief update the controller
+         *
+         * Must be called once every sample period
+         *
+         * @param error the current error
+         * @return Output
+         */
+        constexpr Output update(Error error) {
+            const double e = error.internal();
+            if (first) {
+                prevError = e;
+                first = false;
+            }
+            derivative = cDA * derivative + cDB * (e - prevError);
+            prevError = e;
+            const double raw = cP * e + integral + derivative;
+            const double out = std::clamp(raw, outMin, outMax);
+            switch (antiWindup) {
+                case AntiWindup::None: integral += cI * e; break;
+                case AntiWindup::Clamping:
+                    if (out == raw || (raw > out) != (e > 0)) integral += cI * e;
+                    break;
+                case AntiWindup::BackCalculation: integral += cI * e + cB * (out - raw); break;
+            }
+            return Output(out);
+        }
+
+        /**
+         * @brief reset the integral and derivative
+         */
+        constexpr void reset() {
+            integral = 0;
+            derivative = 0;
+            first = true;
+        }
+    private:
+        double dt; /** sample period */
+        AntiWindup antiWindup = AntiWindup::None;
+        double outMin = -std::numeric_limits<double>::infinity();
+        double outMax = std::numeric_limits<double>::infinity();
+        // difference equation coefficients
+        double cP; /** proportional */
+        double cI; /** integral, ki * dt */
+        double cDA; /** derivative filter pole, tf / (tf + dt) */
+        double cDB; /** derivative, kd / (tf + dt) */
+        double cB = 1; /** back calculation, dt / tracking time */
+        // state
+        double integral = 0;
+        double derivative = 0;
+        double prevError = 0;
+        bool first = true;
+};
+} // namespace units
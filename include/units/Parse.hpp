@@ -0,0 +1,323 @@
+#pragma once
+
+#include "units/Angle.hpp"
+#include "units/Temperature.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace units {
+/**
+ * @brief get the dimensions of a quantity type, as the numerator and denominator of each dimension
+ *
+ * @tparam Q the quantity type
+ * @return std::array<std::int8_t, 16> in the order of the Quantity template parameters
+ */
+template <isQuantity Q> constexpr std::array<std::int8_t, 16> dimensionsOf() {
+    return {static_cast<std::int8_t>(Q::mass::num),        static_cast<std::int8_t>(Q::mass::den),
+            static_cast<std::int8_t>(Q::length::num),      static_cast<std::int8_t>(Q::length::den),
+            static_cast<std::int8_t>(Q::time::num),        static_cast<std::int8_t>(Q::time::den),
+            static_cast<std::int8_t>(Q::current::num),     static_cast<std::int8_t>(Q::current::den),
+            static_cast<std::int8_t>(Q::angle::num),       static_cast<std::int8_t>(Q::angle::den),
+            static_cast<std::int8_t>(Q::temperature::num), static_cast<std::int8_t>(Q::temperature::den),
+            static_cast<std::int8_t>(Q::luminosity::num),  static_cast<std::int8_t>(Q::luminosity::den),
+            static_cast<std::int8_t>(Q::moles::num),       static_cast<std::int8_t>(Q::moles::den)};
+}
+
+/**
+ * @brief hash a string with 32 bit FNV-1a, followed by a finalizer so that every bit of the result is well mixed
+ *
+ * @param text the string to hash
+ * @param seed changes the hash. Different seeds give unrelated hashes
+ * @return constexpr std::uint32_t
+ */
+constexpr std::uint32_t hashString(std::string_view text, std::uint32_t seed = 0) {
+    std::uint32_t hash = 2166136261u ^ (seed * 0x9E3779B9u);
+    for (char c : text) hash = (hash ^ static_cast<std::uint8_t>(c)) * 16777619u;
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6Bu;
+    hash ^= hash >> 13;
+    hash *= 0xC2B2AE35u;
+    return hash ^ (hash >> 16);
+}
+
+/**
+ * @struct UnitParseEntry
+ *
+ * @brief a unit suffix that can be parsed. A value v in the unit is v * scale + offset in base units
+ */
+struct UnitParseEntry {
+        std::string_view suffix; /** the suffix, e.g "in" */
+        double scale; /** the size of the unit, in base units */
+        double offset; /** the offset of the unit, for units that don't start at 0 like celsius */
+        std::array<std::int8_t, 16> dimensions; /** the dimensions of the unit, from dimensionsOf */
+};
+
+/**
+ * @brief create a UnitParseEntry for a unit
+ *
+ * @param suffix the suffix of the unit
+ * @param unit 1 of the unit
+ * @param offset the offset of the unit
+ * @return UnitParseEntry
+ */
+template <isQuantity Q> constexpr UnitParseEntry parseEntry(std::string_view suffix, Q unit, double offset = 0) {
+    return {suffix, unit.internal(), offset, dimensionsOf<Q>()};
+}
+
+// every suffix defined with NEW_UNIT, NEW_UNIT_LITERAL, NEW_METRIC_PREFIXES, and the hand written literals of Angle
+// and Temperature. A suffix added to one of those should be added here too.
+#define PARSE_UNIT(suffix) parseEntry(#suffix, ::suffix)
+#define PARSE_METRIC_PREFIXES(base)                                                                                    \
+    PARSE_UNIT(base), PARSE_UNIT(T##base), PARSE_UNIT(G##base), PARSE_UNIT(M##base), PARSE_UNIT(k##base),              \
+        PARSE_UNIT(c##base), PARSE_UNIT(m##base), PARSE_UNIT(u##base), PARSE_UNIT(n##base)
+
+constexpr std::array unitParseEntries = {
+    // clang-format off
+    PARSE_UNIT(num), PARSE_UNIT(percent),
+    PARSE_UNIT(kg), PARSE_UNIT(g), PARSE_UNIT(lb),
+    PARSE_METRIC_PREFIXES(sec), PARSE_UNIT(min), PARSE_UNIT(hr), PARSE_UNIT(day),
+    PARSE_METRIC_PREFIXES(m), PARSE_UNIT(in), PARSE_UNIT(ft), PARSE_UNIT(yd), PARSE_UNIT(mi), PARSE_UNIT(tile),
+    PARSE_UNIT(m2), PARSE_UNIT(Tm2), PARSE_UNIT(Gm2), PARSE_UNIT(Mm2), PARSE_UNIT(km2), PARSE_UNIT(cm2),
+    PARSE_UNIT(mm2), PARSE_UNIT(um2), PARSE_UNIT(nm2), PARSE_UNIT(in2),
+    PARSE_METRIC_PREFIXES(mps), PARSE_METRIC_PREFIXES(mph), PARSE_UNIT(inps), PARSE_UNIT(miph),
+    PARSE_METRIC_PREFIXES(mps2), PARSE_METRIC_PREFIXES(mph2), PARSE_UNIT(inps2), PARSE_UNIT(miph2),
+    PARSE_METRIC_PREFIXES(mps3), PARSE_METRIC_PREFIXES(mph3), PARSE_UNIT(inps3), PARSE_UNIT(miph3),
+    PARSE_UNIT(radpm), PARSE_UNIT(kgm2), PARSE_UNIT(N), PARSE_UNIT(Nm), PARSE_UNIT(watt), PARSE_UNIT(amp),
+    PARSE_UNIT(coulomb), PARSE_METRIC_PREFIXES(volt), PARSE_METRIC_PREFIXES(ohm), PARSE_METRIC_PREFIXES(siemen),
+    PARSE_UNIT(candela), PARSE_UNIT(mol),
+    PARSE_UNIT(rad), PARSE_UNIT(deg), PARSE_UNIT(rot),
+    parseEntry("stRad", rad), parseEntry("stDeg", deg), parseEntry("stRot", rot),
+    // compass angles are clockwise from north: standard = 90 deg - compass
+    parseEntry("cRad", -rad, M_PI_2), parseEntry("cDeg", -deg, M_PI_2), parseEntry("cRot", -rot, M_PI_2),
+    PARSE_UNIT(radps), PARSE_UNIT(degps), PARSE_UNIT(rps), PARSE_UNIT(rpm),
+    PARSE_UNIT(radps2), PARSE_UNIT(degps2), PARSE_UNIT(rps2), PARSE_UNIT(rpm2),
+    PARSE_UNIT(radps3), PARSE_UNIT(rps3), PARSE_UNIT(rpm3),
+    PARSE_UNIT(kelvin), parseEntry("celsius", kelvin, 273.15),
+    parseEntry("fahrenheit", kelvin * (5.0 / 9.0), 273.15 - 32 * (5.0 / 9.0)),
+    // clang-format on
+};
+
+#undef PARSE_METRIC_PREFIXES
+#undef PARSE_UNIT
+
+/**
+ * @class UnitTable
+ *
+ * @brief a perfect hash table of unit suffixes, built at compile time
+ *
+ * Suffixes are hashed into buckets, and each bucket has a seed, chosen at compile time, which hashes the suffixes in it
+ * to slots no other suffix uses. Looking a suffix up takes 2 hashes and 1 string comparison, whatever the number of
+ * units.
+ *
+ * @tparam N the number of suffixes
+ */
+template <std::size_t N> class UnitTable {
+        static_assert(N < 0xFFFF, "slots hold 16 bit indices");
+        static constexpr std::size_t slotCount = std::bit_ceil(2 * N);
+        static constexpr std::size_t bucketCount = slotCount / 8;
+    public:
+        /**
+         * @brief Construct a new UnitTable object. Must be evaluated at compile time
+         *
+         * @param entries the units. Suffixes must be unique
+         */
+        consteval UnitTable(const std::array<UnitParseEntry, N>& entries) : entries(entries) {
+            std::array<std::uint16_t, N> bucketOf {};
+            std::array<std::size_t, bucketCount> sizes {};
+            for (std::size_t i = 0; i < N; i++) {
+                bucketOf[i] = hashString(entries[i].suffix) % bucketCount;
+                sizes[bucketOf[i]]++;
+            }
+            // place the largest buckets first, while there are the most free slots
+            for (std::size_t size = N; size > 0; size--) {
+                for (std::size_t bucket = 0; bucket < bucketCount; bucket++) {
+                    if (sizes[bucket] == size) place(bucket, bucketOf);
+                }
+            }
+        }
+
+        /**
+         * @brief find a unit by its suffix
+         *
+         * @param suffix the suffix, e.g "in"
+         * @return const UnitParseEntry* nullptr if there is no unit with the suffix
+         */
+        constexpr const UnitParseEntry* find(std::string_view suffix) const {
+            const std::uint32_t seed = seeds[hashString(suffix) % bucketCount];
+            const std::uint16_t slot = slots[hashString(suffix, seed) % slotCount];
+            if (slot == 0 || entries[slot - 1].suffix != suffix) return nullptr;
+            return &entries[slot - 1];
+        }
+    private:
+        /**
+         * @brief find a seed that places every suffix of a bucket in a free slot, and place them
+         */
+        consteval void place(std::size_t bucket, const std::array<std::uint16_t, N>& bucketOf) {
+            for (std::uint16_t seed = 1;; seed++) {
+                std::array<std::uint16_t, slotCount> trial = slots;
+                bool fits = true;
+                for (std::size_t i = 0; i < N && fits; i++) {
+                    if (bucketOf[i] != bucket) continue;
+                    std::uint16_t& slot = trial[hashString(entries[i].suffix, seed) % slotCount];
+                    fits = slot == 0;
+                    slot = static_cast<std::uint16_t>(i + 1);
+                }
+                if (!fits) continue;
+                slots = trial;
+                seeds[bucket] = seed;
+                return;
+            }
+        }
+
+        std::array<UnitParseEntry, N> entries;
+        std::array<std::uint16_t, bucketCount> seeds {}; /** the seed of each bucket */
+        std::array<std::uint16_t, slotCount> slots {}; /** index + 1 of the entry in each slot, or 0 if it's empty */
+};
+
+inline constexpr UnitTable unitTable(unitParseEntries);
+
+/**
+ * @brief check whether a quantity type has a unit with a suffix that can be parsed
+ *
+ * @tparam Q the quantity type
+ * @return true some unit in the table has the dimensions of Q
+ * @return false Q has no named unit, e.g Divided<Voltage, Length>
+ */
+template <isQuantity Q> constexpr bool hasParsableUnit() {
+    return std::any_of(unitParseEntries.begin(), unitParseEntries.end(),
+                       [](const UnitParseEntry& entry) { return entry.dimensions == dimensionsOf<Q>(); });
+}
+
+/**
+ * @brief the reason text could not be parsed
+ */
+enum class ParseError : std::uint8_t {
+    None, /** the text was parsed */
+    InvalidNumber, /** the text doesn't start with a number */
+    UnknownUnit, /** the suffix isn't the suffix of any unit */
+    WrongDimension, /** the unit doesn't have the dimensions of the quantity type, or a bare number has a unit */
+};
+
+/**
+ * @struct ParseResult
+ *
+ * @brief the result of parsing one quantity
+ */
+template <isQuantity Q> struct ParseResult {
+        Q value = Q(0.0); /** the parsed quantity. 0 if parsing failed */
+        const char* ptr; /** one past the last character parsed, or where parsing failed */
+        ParseError error; /** ParseError::None if the quantity was parsed */
+};
+
+/**
+ * @brief parse a quantity at the start of some text, e.g "12.5 in" or "90_cDeg"
+ *
+ * Leading whitespace is skipped. The number is parsed with std::from_chars, so it is locale independent and never
+ * allocates. The number can be followed by spaces or an underscore, then the suffix of any unit defined by this
+ * library, which is looked up in a perfect hash table built at compile time. The unit must have the same dimensions as
+ * Q, so "3 rpm" can be parsed as an AngularVelocity but not as a Length.
+ *
+ * A bare number without a suffix is a Number. It is also accepted for a quantity type that has no named unit, like the
+ * Divided<Voltage, Length> gain of a PID controller, and is in base units, since there is no suffix it could be
+ * written with.
+ *
+ * @tparam Q the quantity type to parse
+ * @param text the text
+ * @return ParseResult<Q>
+ */
+template <isQuantity Q> ParseResult<Q> parsePrefix(std::string_view text) {
+    const char* p = text.data();
+    const char* const end = p + text.size();
+    while (p != end && (*p == ' ' || *p == '\t')) p++;
+    if (p != end && *p == '+' && end - p > 1 && p[1] != '-') p++;
+    double number;
+    const std::from_chars_result parsed = std::from_chars(p, end, number);
+    if (parsed.ec != std::errc()) return {Q(0.0), p, ParseError::InvalidNumber};
+    p = parsed.ptr;
+    // the suffix can be separated from the number, but then an empty suffix would consume the separator
+    const char* suffixStart = p;
+    while (suffixStart != end && (*suffixStart == ' ' || *suffixStart == '\t')) suffixStart++;
+    if (suffixStart != end && *suffixStart == '_') suffixStart++;
+    const auto isLetter = [](char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'); };
+    const char* suffixEnd = suffixStart;
+    // suffixes start with a letter, so a number after a space isn't mistaken for one
+    if (suffixEnd != end && isLetter(*suffixEnd)) {
+        while (suffixEnd != end && (isLetter(*suffixEnd) || (*suffixEnd >= '0' && *suffixEnd <= '9'))) suffixEnd++;
+    }
+    if (suffixEnd == suffixStart) {
+        if (dimensionsOf<Q>() != dimensionsOf<Number>() && hasParsableUnit<Q>()) {
+            return {Q(0.0), p, ParseError::WrongDimension};
+        }
+        return {Q(number), p, ParseError::None};
+    }
+    const UnitParseEntry* unit = unitTable.find(std::string_view(suffixStart, suffixEnd - suffixStart));
+    if (unit == nullptr) return {Q(0.0), suffixStart, ParseError::UnknownUnit};
+    if (unit->dimensions != dimensionsOf<Q>()) return {Q(0.0), suffixStart, ParseError::WrongDimension};
+    return {Q(number * unit->scale + unit->offset), suffixEnd, ParseError::None};
+}
+
+/**
+ * @brief parse text that holds exactly one quantity, e.g "12.5 in"
+ *
+ * @tparam Q the quantity type to parse
+ * @param text the text. Whitespace around the quantity is ignored
+ * @return std::optional<Q> the quantity, or std::nullopt if the text couldn't be parsed. Use parsePrefix to find out
+ * why
+ */
+template <isQuantity Q> std::optional<Q> parse(std::string_view text) {
+    const ParseResult<Q> result = parsePrefix<Q>(text);
+    if (result.error != ParseError::None) return std::nullopt;
+    for (const char* p = result.ptr; p != text.data() + text.size(); p++) {
+        if (*p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') return std::nullopt;
+    }
+    return result.value;
+}
+
+/**
+ * @struct ParseAllResult
+ *
+ * @brief the result of parsing a list of quantities
+ */
+struct ParseAllResult {
+        std::size_t count; /** the number of quantities parsed */
+        const char* ptr; /** one past the last character parsed, or where parsing failed */
+        ParseError error; /** ParseError::None if every quantity in the text was parsed */
+};
+
+/**
+ * @brief parse a list of quantities, e.g a file of waypoints
+ *
+ * Quantities are separated by whitespace, newlines, or commas. Parsing stops at the end of the text, or at the first
+ * error.
+ * @code
+ * std::array<double, 64> inches;
+ * ParseAllResult result = units::parseAll<Length>("24 in, 1 tile\n0.5 m", [&, i = 0](Length distance) mutable {
+ *     if (i < inches.size()) inches[i++] = to_in(distance);
+ * });
+ * @endcode
+ *
+ * @tparam Q the quantity type to parse
+ * @param text the text
+ * @param onValue called with each quantity, in order
+ * @return ParseAllResult
+ */
+template <isQuantity Q, typename F> ParseAllResult parseAll(std::string_view text, F&& onValue) {
+    const char* p = text.data();
+    const char* const end = p + text.size();
+    std::size_t count = 0;
+    while (true) {
+        while (p != end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n' || *p == ',')) p++;
+        if (p == end) return {count, p, ParseError::None};
+        const ParseResult<Q> result = parsePrefix<Q>(std::string_view(p, end - p));
+        if (result.error != ParseError::None) return {count, result.ptr, result.error};
+        onValue(result.value);
+        count++;
+        p = result.ptr;
+    }
+}
+} // namespace units
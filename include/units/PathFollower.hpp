@@ -0,0 +1,123 @@
+#pragma once
+
+#include "units/Vector2D.hpp"
+#include <span>
+
+namespace units {
+/**
+ * @class PathFollower
+ *
+ * @brief finds the pure pursuit lookahead point on a path of line segments
+ *
+ * The follower keeps a cursor into the path, which only ever moves forwards. Each update first moves the cursor to the
+ * point on the path closest to the robot, walking forwards while the next segment is closer, so a robot that starts
+ * partway along the path or drifts off it isn't pulled back to where it left. It then walks over segments whose end is
+ * within the lookahead circle. Both walks start from the cursor and only compare squared distances, so the cost of an
+ * update is proportional to how far the robot moved rather than the length of the path. The intersection with the
+ * first segment leaving the circle is solved in closed form.
+ */
+class PathFollower {
+    public:
+        /**
+         * @brief Construct a new PathFollower object
+         *
+         * @param path the points of the path. The path is not copied, so it must outlive the follower
+         * @param lookahead the lookahead distance
+         */
+        constexpr PathFollower(std::span<const V2Position> path, Length lookahead)
+            : path(path),
+              lookaheadSquared(square(lookahead)) {}
+
+        /**
+         * @brief find the lookahead point, and move the cursor up to it
+         *
+         * If the path doesn't intersect the lookahead circle past the cursor (e.g the robot is too far away from the
+         * path), the point at the cursor, which is the closest point on the path, is returned instead.
+         *
+         * @param robot the position of the robot
+         * @return V2Position the lookahead point
+         */
+        constexpr V2Position update(V2Position robot) {
+            if (path.empty()) return robot;
+            if (path.size() == 1) return path[0];
+            // move to the closest segment. Stops at the first local minimum, so a path that passes near itself
+            // later isn't skipped to
+            while (segment + 1 < path.size() - 1 &&
+                   distanceSquared(segment + 1, robot) < distanceSquared(segment, robot)) {
+                segment++;
+                fraction = 0;
+            }
+            fraction = std::max(fraction, projection(segment, robot));
+            // skip segments that end inside the lookahead circle, the lookahead point is further along
+            while (segment + 1 < path.size() - 1 && (path[segment + 1] - robot) * (path[segment + 1] - robot) <
+                                                        lookaheadSquared) {
+                segment++;
+                fraction = 0;
+            }
+            const V2Position start = path[segment];
+            const V2Position d = path[segment + 1] - start;
+            const V2Position f = start - robot;
+            // solve |start + d * t - robot|^2 = lookahead^2 for the furthest t
+            const double a = (d * d).internal();
+            const double b = 2 * (f * d).internal();
+            const double c = (f * f - lookaheadSquared).internal();
+            const double discriminant = b * b - 4 * a * c;
+            if (a > 0 && discriminant >= 0) {
+                const double t = (-b + std::sqrt(discriminant)) / (2 * a);
+                if (t >= 0) fraction = std::clamp(t, fraction, 1.0);
+            }
+            return start + d * fraction;
+        }
+
+        /**
+         * @brief get the index of the segment the cursor is on
+         *
+         * @return std::size_t the index of the first point of the segment
+         */
+        constexpr std::size_t index() const { return segment; }
+
+        /**
+         * @brief whether the cursor has reached the end of the path
+         *
+         * @return true the cursor is at the last point of the path
+         */
+        constexpr bool finished() const { return path.size() < 2 || (segment + 2 == path.size() && fraction >= 1); }
+
+        /**
+         * @brief move the cursor back to the start of the path
+         */
+        constexpr void reset() {
+            segment = 0;
+            fraction = 0;
+        }
+
+        /**
+         * @brief set the lookahead distance
+         *
+         * @param lookahead the new lookahead distance
+         */
+        constexpr void setLookahead(Length lookahead) { lookaheadSquared = square(lookahead); }
+    private:
+        /**
+         * @brief how far along a segment the point closest to a position is, from 0 to 1
+         */
+        constexpr double projection(std::size_t i, V2Position position) const {
+            const V2Position d = path[i + 1] - path[i];
+            const double a = (d * d).internal();
+            return a > 0 ? std::clamp(((position - path[i]) * d).internal() / a, 0.0, 1.0) : 0;
+        }
+
+        /**
+         * @brief the squared distance from a position to the closest point of a segment
+         */
+        constexpr double distanceSquared(std::size_t i, V2Position position) const {
+            const V2Position offset = path[i] + (path[i + 1] - path[i]) * projection(i, position) - position;
+            return (offset * offset).internal();
+        }
+
+        std::span<const V2Position> path;
+        Area lookaheadSquared;
+        std::size_t segment = 0; /** index of the first point of the segment the cursor is on */
+        double fraction = 0; /** how far along its segment the cursor is, from 0 to 1 */
+};
+} // namespace units
@@ -0,0 +1,247 @@
+#pragma once
+
+#include "pros/rtos.hpp"
+#include "units/Timestamp.hpp"
+#include <array>
+#include <limits>
+#include <span>
+
+namespace units {
+/**
+ * @class TimeHistogram
+ *
+ * @brief a histogram of durations, with equal width bins
+ *
+ * Durations are recorded in integer microseconds, so recording one is an integer divide and a few adds. The last bin
+ * also counts every duration past the end of the histogram. The minimum, maximum, and mean are exact, not binned.
+ *
+ * @tparam N the number of bins
+ */
+template <std::size_t N> class TimeHistogram {
+    public:
+        /**
+         * @brief Construct a new TimeHistogram object
+         *
+         * @param range the duration the bins cover, starting from 0
+         */
+        constexpr TimeHistogram(Time range)
+            : width(std::max<std::int64_t>(toMicros(range) / N, 1)) {}
+
+        /**
+         * @brief record a duration
+         *
+         * @param us the duration, in microseconds. Negative durations are recorded as 0
+         */
+        constexpr void add(std::int64_t us) {
+            us = std::max<std::int64_t>(us, 0);
+            counts[std::min<std::int64_t>(us / width, N - 1)]++;
+            total++;
+            sum += us;
+            lowest = std::min(lowest, us);
+            highest = std::max(highest, us);
+        }
+
+        /**
+         * @brief record a duration
+         *
+         * @param time the duration
+         */
+        constexpr void add(Time time) { add(toMicros(time)); }
+
+        /**
+         * @brief get the count in each bin
+         *
+         * @return std::span<const std::uint32_t>
+         */
+        constexpr std::span<const std::uint32_t> bins() const { return counts; }
+
+        /**
+         * @brief get the width of each bin
+         *
+         * @return Time
+         */
+        constexpr Time binWidth() const { return Time(width * 1e-6); }
+
+        /**
+         * @brief get the number of durations recorded
+         *
+         * @return std::uint32_t
+         */
+        constexpr std::uint32_t count() const { return total; }
+
+        /**
+         * @brief get the shortest duration recorded
+         *
+         * @return Time 0 if nothing has been recorded
+         */
+        constexpr Time min() const { return Time(total ? lowest * 1e-6 : 0.0); }
+
+        /**
+         * @brief get the longest duration recorded
+         *
+         * @return Time 0 if nothing has been recorded
+         */
+        constexpr Time max() const { return Time(total ? highest * 1e-6 : 0.0); }
+
+        /**
+         * @brief get the mean duration recorded
+         *
+         * @return Time 0 if nothing has been recorded
+         */
+        constexpr Time mean() const { return Time(total ? sum * 1e-6 / total : 0.0); }
+
+        /**
+         * @brief get the duration that a fraction of the recorded durations are shorter than
+         *
+         * The result is the upper edge of the bin the percentile falls in, so it's rounded up to a multiple of the bin
+         * width, and is capped at the maximum
+         *
+         * @param fraction the fraction, between 0 and 1. 0.5 is the median, 0.99 is the 99th percentile
+         * @return Time
+         */
+        constexpr Time percentile(Number fraction) const {
+            const double target = fraction.internal() * total;
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < N; i++) {
+                seen += counts[i];
+                if (seen >= target && seen > 0) return units::min(Time((i + 1) * width * 1e-6), max());
+            }
+            return max();
+        }
+
+        /**
+         * @brief remove every recorded duration
+         */
+        constexpr void reset() {
+            counts.fill(0);
+            total = 0;
+            sum = 0;
+            lowest = std::numeric_limits<std::int64_t>::max();
+            highest = 0;
+        }
+    private:
+        /**
+         * @brief round a time to the nearest microsecond
+         */
+        constexpr static std::int64_t toMicros(Time time) {
+            const double us = to_usec(time);
+            return static_cast<std::int64_t>(us >= 0 ? us + 0.5 : us - 0.5);
+        }
+
+        std::int64_t width; /** in microseconds */
+        std::array<std::uint32_t, N> counts {};
+        std::uint32_t total = 0;
+        std::int64_t sum = 0; /** in microseconds */
+        std::int64_t lowest = std::numeric_limits<std::int64_t>::max(); /** in microseconds */
+        std::int64_t highest = 0; /** in microseconds */
+};
+
+/**
+ * @class PeriodicLoop
+ *
+ * @brief runs a loop at a fixed rate, and measures how well it keeps to it
+ *
+ * pros::Task::delay_until only has millisecond resolution. PeriodicLoop keeps its deadlines in microseconds: wait()
+ * sleeps until the deadline is less than the spin time away, then spins for the rest. Each deadline is a whole
+ * number of periods after an origin, rounded to the microsecond once, so rounding errors don't accumulate even when the
+ * period isn't a whole number of microseconds.
+ *
+ * It records 3 histograms:
+ * - the actual period between the starts of consecutive iterations, which shows jitter
+ * - the execution time of each iteration, from the start of the iteration to the call to wait()
+ * - overruns: how late an iteration finished, for iterations that missed their deadline
+ *
+ * After an overrun, the missed deadlines are skipped, the next iteration starts immediately, and deadlines are counted
+ * from then.
+ * @code
+ * PeriodicLoop loop(10_msec);
+ * while (true) {
+ *     // do things
+ *     loop.wait();
+ * }
+ * @endcode
+ *
+ * @tparam N the number of bins in each histogram
+ */
+template <std::size_t N = 32> class PeriodicLoop {
+    public:
+        /**
+         * @brief Construct a new PeriodicLoop object
+         *
+         * The first iteration starts on construction
+         *
+         * @param period the time between the starts of iterations
+         * @param spin how long to busy wait before each deadline, instead of sleeping
+         */
+        PeriodicLoop(Time period, Time spin = 1_msec)
+            : period(period),
+              spin(spin),
+              periods(period * 2),
+              executions(period),
+              overruns(period),
+              start(Timestamp::now()),
+              origin(start),
+              deadline(start + period) {}
+
+        /**
+         * @brief wait until the start of the next iteration
+         */
+        void wait() {
+            Timestamp now = Timestamp::now();
+            executions.add(now.microsSince(start));
+            if (now >= deadline) {
+                overruns.add(now.microsSince(deadline));
+                origin = now;
+                ticks = 0;
+            } else {
+                const std::int64_t sleep = (deadline - spin).microsSince(now) / 1000;
+                if (sleep > 0) pros::delay(sleep);
+                while ((now = Timestamp::now()) < deadline);
+            }
+            periods.add(now.microsSince(start));
+            start = now;
+            ticks++;
+            deadline = Timestamp(origin.micros() + static_cast<std::uint64_t>(to_usec(period) * ticks + 0.5));
+        }
+
+        /**
+         * @brief get the histogram of the actual period between iterations
+         *
+         * @return const TimeHistogram<N>&
+         */
+        const TimeHistogram<N>& periodHistogram() const { return periods; }
+
+        /**
+         * @brief get the histogram of the execution time of iterations
+         *
+         * @return const TimeHistogram<N>&
+         */
+        const TimeHistogram<N>& executionHistogram() const { return executions; }
+
+        /**
+         * @brief get the histogram of how late iterations that missed their deadline finished
+         *
+         * @return const TimeHistogram<N>&
+         */
+        const TimeHistogram<N>& overrunHistogram() const { return overruns; }
+
+        /**
+         * @brief clear every histogram
+         */
+        void resetStatistics() {
+            periods.reset();
+            executions.reset();
+            overruns.reset();
+        }
+    private:
+        Time period;
+        Time spin;
+        TimeHistogram<N> periods;
+        TimeHistogram<N> executions;
+        TimeHistogram<N> overruns;
+        Timestamp start; /** when the current iteration started */
+        Timestamp origin; /** when deadlines are counted from. Moved to the end of the last overrun */
+        std::uint32_t ticks = 1; /** periods from the origin to the deadline */
+        Timestamp deadline; /** when the next iteration should start */
+};
+} // namespace units
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+namespace units {
+/**
+ * @class Published
+ *
+ * @brief a value written by one task, and read by any number of other tasks, without locks
+ *
+ * The value is guarded by a sequence lock. The sequence is odd while the value is being written. A reader copies the
+ * value, and retries if the sequence was odd or changed while it was copying. Publishing never waits for readers, so a
+ * low priority reader can't delay the writer, and a reader never blocks on a lower priority writer, so there is no
+ * priority inversion. Readers only retry if they overlap a write, which is rare for values as small as a Pose.
+ *
+ * Only one task may publish at a time.
+ *
+ * @tparam T the type of the value, e.g Pose. Must be trivially copyable
+ */
+template <typename T> class Published {
+        static_assert(std::is_trivially_copyable_v<T>, "values are copied while they may be written");
+    public:
+        /**
+         * @brief Construct a new Published object
+         *
+         * @param initial the value before anything is published
+         */
+        constexpr Published(const T& initial) : value(initial) {}
+
+        /**
+         * @brief Construct a new Published object
+         *
+         * This constructor default-initializes the value
+         */
+        constexpr Published()
+            requires std::is_default_constructible_v<T>
+            : value() {}
+
+        Published(const Published&) = delete;
+        Published& operator=(const Published&) = delete;
+
+        /**
+         * @brief publish a new value. Never blocks
+         *
+         * @param next the new value
+         */
+        void publish(const T& next) {
+            const std::uint32_t s = sequence.load(std::memory_order_relaxed);
+            sequence.store(s + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            value = next;
+            sequence.store(s + 2, std::memory_order_release);
+        }
+
+        /**
+         * @brief try to copy the latest value once
+         *
+         * @param out where to copy the value to. May be partially written if the read fails
+         * @return true the copy is consistent
+         * @return false the copy overlapped a publish
+         */
+        bool tryRead(T& out) const {
+            const std::uint32_t before = sequence.load(std::memory_order_acquire);
+            out = value;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return !(before & 1) && before == sequence.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief copy the latest value, retrying until the copy is consistent
+         *
+         * @return T
+         */
+        T read() const {
+            // the first copy only initializes out, without requiring T to be default constructible
+            T out = value;
+            while (!tryRead(out));
+            return out;
+        }
+
+        /**
+         * @brief get the number of values published so far
+         *
+         * Can be compared with an earlier version to check for a new value without copying it
+         *
+         * @return std::uint32_t
+         */
+        std::uint32_t version() const { return sequence.load(std::memory_order_acquire) / 2; }
+    private:
+        T value;
+        std::atomic<std::uint32_t> sequence = 0;
+};
+} // namespace units
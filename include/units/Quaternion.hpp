@@ -0,0 +1,86 @@
+#pragma once
+
+#include "units/Vector3D.hpp"
+
+namespace units {
+/**
+ * @class Quaternion
+ *
+ * @brief a unit quaternion, representing an orientation in 3D space
+ */
+class Quaternion {
+    public:
+        Number w; /** w component */
+        Number x; /** x component */
+        Number y; /** y component */
+        Number z; /** z component */
+
+        /**
+         * @brief Construct a new Quaternion object
+         *
+         * This constructor initializes the quaternion to the identity rotation
+         */
+        constexpr Quaternion() : w(1.0), x(0.0), y(0.0), z(0.0) {}
+
+        /**
+         * @brief Construct a new Quaternion object
+         *
+         * @param w w component
+         * @param x x component
+         * @param y y component
+         * @param z z component
+         */
+        constexpr Quaternion(Number w, Number x, Number y, Number z) : w(w), x(x), y(y), z(z) {}
+
+        /**
+         * @brief Create a new Quaternion object from a rotation around an axis
+         *
+         * @param axis the axis to rotate around
+         * @param angle the angle to rotate by, counterclockwise around the axis
+         * @return Quaternion
+         */
+        template <isQuantity T> constexpr static Quaternion fromAxisAngle(const Vector3D<T>& axis, Angle angle) {
+            const Vector3D<Number> a = axis / axis.magnitude();
+            const Number s = sin(angle / 2.0);
+            return Quaternion(cos(angle / 2.0), a.x * s, a.y * s, a.z * s);
+        }
+
+        /**
+         * @brief * operator overload. Composes two rotations, applying the right hand side first
+         *
+         * @param other the rotation to apply first
+         * @return Quaternion
+         */
+        constexpr Quaternion operator*(const Quaternion& other) const {
+            return Quaternion(w * other.w - x * other.x - y * other.y - z * other.z,
+                              w * other.x + x * other.w + y * other.z - z * other.y,
+                              w * other.y - x * other.z + y * other.w + z * other.x,
+                              w * other.z + x * other.y - y * other.x + z * other.w);
+        }
+
+        /**
+         * @brief get the inverse rotation
+         *
+         * @return Quaternion
+         */
+        constexpr Quaternion conjugate() const { return Quaternion(w, -x, -y, -z); }
+
+        /**
+         * @brief rotate a vector
+         *
+         * @param v the vector to rotate
+         * @return Vector3D<T>
+         */
+        template <isQuantity T> constexpr Vector3D<T> rotate(const Vector3D<T>& v) const {
+            const Quaternion r = *this * Quaternion(0.0, v.x.internal(), v.y.internal(), v.z.internal()) * conjugate();
+            return Vector3D<T>(T(r.x.internal()), T(r.y.internal()), T(r.z.internal()));
+        }
+
+        /**
+         * @brief get the rotation around the z axis
+         *
+         * @return Angle
+         */
+        constexpr Angle yaw() const { return atan2(2.0 * (w * z + x * y), Number(1.0) - 2.0 * (y * y + z * z)); }
+};
+} // namespace units
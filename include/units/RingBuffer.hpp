@@ -0,0 +1,173 @@
+#pragma once
+
+#include "units/units.hpp"
+#include <array>
+#include <atomic>
+#include <optional>
+#include <span>
+
+namespace units {
+/**
+ * @struct TimedSample
+ *
+ * @brief a quantity, and when it was measured
+ */
+template <isQuantity Q> struct TimedSample {
+        Time time = Time(0.0); /** when the value was measured */
+        Q value = Q(0.0); /** the value */
+};
+
+/**
+ * @class RingBuffer
+ *
+ * @brief a lock-free single producer, single consumer queue of timestamped quantities
+ *
+ * One task pushes, and one other task pops. Neither ever blocks or allocates, so a slow consumer can't hold up a fast
+ * producer, and there is no priority inversion. When the buffer is full, pushes fail instead of overwriting samples
+ * the consumer hasn't read.
+ *
+ * The read and write indices count up forever, and are masked into the buffer, so N must be a power of 2. Each index
+ * lives on its own cache line, and the producer keeps a cached copy of the read index, which it only refreshes when the
+ * buffer looks full.
+ *
+ * @tparam Q the quantity type of the samples
+ * @tparam N the capacity of the buffer. Must be a power of 2
+ */
+template <isQuantity Q, std::size_t N> class RingBuffer {
+        static_assert(N > 0 && (N & (N - 1)) == 0, "capacity must be a power of 2");
+        static constexpr std::size_t cacheLine = 64;
+    public:
+        using Sample = TimedSample<Q>;
+
+        /**
+         * @struct View
+         *
+         * @brief the samples waiting to be popped, as up to 2 contiguous ranges in the buffer
+         */
+        struct View {
+                std::span<const Sample> first; /** oldest samples */
+                std::span<const Sample> second; /** newer samples, if the samples wrap around the end of the buffer */
+
+                /**
+                 * @brief get the total number of samples in the view
+                 *
+                 * @return std::size_t
+                 */
+                std::size_t size() const { return first.size() + second.size(); }
+        };
+
+        /**
+         * @brief push a sample. Producer only
+         *
+         * @param time when the value was measured
+         * @param value the value
+         * @return true the sample was pushed
+         * @return false the buffer is full
+         */
+        bool push(Time time, Q value) {
+            const Sample sample {time, value};
+            return push(std::span<const Sample>(&sample, 1)) == 1;
+        }
+
+        /**
+         * @brief push as many samples as fit. Producer only
+         *
+         * @param samples the samples to push, oldest first
+         * @return std::size_t the number of samples pushed
+         */
+        std::size_t push(std::span<const Sample> samples) {
+            const std::size_t head = writeIndex.load(std::memory_order_relaxed);
+            if (head - cachedReadIndex + samples.size() > N) {
+                cachedReadIndex = readIndex.load(std::memory_order_acquire);
+            }
+            const std::size_t n = std::min(samples.size(), N - (head - cachedReadIndex));
+            for (std::size_t i = 0; i < n; i++) buffer[(head + i) & mask] = samples[i];
+            writeIndex.store(head + n, std::memory_order_release);
+            return n;
+        }
+
+        /**
+         * @brief pop the oldest sample. Consumer only
+         *
+         * @return std::optional<Sample> the sample, or std::nullopt if the buffer is empty
+         */
+        std::optional<Sample> pop() {
+            Sample out;
+            if (pop(std::span<Sample>(&out, 1)) == 0) return std::nullopt;
+            return out;
+        }
+
+        /**
+         * @brief pop as many samples as are available, up to the size of the output. Consumer only
+         *
+         * @param out buffer for the samples, oldest first
+         * @return std::size_t the number of samples popped
+         */
+        std::size_t pop(std::span<Sample> out) {
+            const View v = view();
+            const std::size_t n = std::min(out.size(), v.size());
+            for (std::size_t i = 0; i < n; i++) out[i] = i < v.first.size() ? v.first[i] : v.second[i - v.first.size()];
+            consume(n);
+            return n;
+        }
+
+        /**
+         * @brief look at the samples waiting to be popped without copying them. Consumer only
+         *
+         * The samples stay valid until they are consumed
+         *
+         * @return View
+         */
+        View view() {
+            const std::size_t tail = readIndex.load(std::memory_order_relaxed);
+            const std::size_t size = writeIndex.load(std::memory_order_acquire) - tail;
+            const std::size_t start = tail & mask;
+            const std::size_t firstSize = std::min(size, N - start);
+            return {std::span<const Sample>(buffer.data() + start, firstSize),
+                    std::span<const Sample>(buffer.data(), size - firstSize)};
+        }
+
+        /**
+         * @brief remove the oldest samples. Consumer only
+         *
+         * @param n how many samples to remove. Must not be more than the size of the last view
+         */
+        void consume(std::size_t n) {
+            readIndex.store(readIndex.load(std::memory_order_relaxed) + n, std::memory_order_release);
+        }
+
+        /**
+         * @brief get the number of samples in the buffer
+         *
+         * The result may be out of date by the time it's used, if the other side is active
+         *
+         * @return std::size_t
+         */
+        std::size_t size() const {
+            return writeIndex.load(std::memory_order_acquire) - readIndex.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief whether the buffer is empty
+         *
+         * @return true the buffer is empty
+         * @return false the buffer is not empty
+         */
+        bool empty() const { return size() == 0; }
+
+        /**
+         * @brief get the maximum number of samples in the buffer
+         *
+         * @return std::size_t
+         */
+        constexpr static std::size_t capacity() { return N; }
+    private:
+        static constexpr std::size_t mask = N - 1;
+        // producer side
+        alignas(cacheLine) std::atomic<std::size_t> writeIndex = 0;
+        std::size_t cachedReadIndex = 0;
+        // consumer side
+        alignas(cacheLine) std::atomic<std::size_t> readIndex = 0;
+        alignas(cacheLine) std::array<Sample, N> buffer {};
+};
+} // namespace units
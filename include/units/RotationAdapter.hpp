@@ -0,0 +1,99 @@
+#pragma once
+
+#include "pros/error.h"
+#include "pros/rotation.hpp"
+#include "pros/rtos.hpp"
+#include "units/Angle.hpp"
+#include "units/Timestamp.hpp"
+#include "units/VelocityEstimator.hpp"
+#include <optional>
+
+namespace units {
+/**
+ * @class RotationAdapter
+ *
+ * @brief a typed view of a pros::Rotation, with a better velocity estimate
+ *
+ * The velocity reported by the rotation sensor is very noisy at low speed. Instead, this adapter feeds the unwrapped
+ * position into a velocity estimator, such as LinearFitEstimator or AlphaBetaEstimator, timestamped with pros::micros.
+ *
+ * The sensor only produces a new reading once every data rate. update() can be called more often than that, e.g from
+ * a loop shared with other devices, and skips calls less than half a data rate after the last sample. Those would
+ * re-read the same reading with a later timestamp, which biases the velocity estimate towards 0. The threshold is half
+ * the data rate rather than all of it, so that a loop running at the data rate isn't skipped every time scheduler
+ * jitter makes a call slightly early.
+ *
+ * @tparam Estimator the velocity estimator, e.g LinearFitEstimator<Angle, 8>
+ */
+template <typename Estimator> class RotationAdapter {
+    public:
+        /**
+         * @brief Construct a new RotationAdapter object
+         *
+         * @param rotation the rotation sensor to read from. Must outlive the adapter
+         * @param estimator the velocity estimator
+         * @param dataRate how often the sensor produces a new reading. Rounded up to a multiple of 5ms
+         */
+        RotationAdapter(const pros::Rotation& rotation, Estimator estimator, Time dataRate = 10_msec)
+            : rotation(rotation),
+              estimator(estimator),
+              minInterval(roundDataRate(dataRate) / 2) {
+            rotation.set_data_rate(static_cast<std::uint32_t>(to_msec(roundDataRate(dataRate))));
+        }
+
+        /**
+         * @brief read the sensor, timestamped with pros::micros
+         */
+        void update() { update(Timestamp::now()); }
+
+        /**
+         * @brief read the sensor
+         *
+         * @param now the current time
+         */
+        void update(Timestamp now) {
+            if (lastSample && now - *lastSample < minInterval) return;
+            const std::int32_t raw = rotation.get_position();
+            if (raw == PROS_ERR) return;
+            if (!lastSample) epoch = now;
+            lastSample = now;
+            estimator.add(now - epoch, Angle(raw * centidegree));
+        }
+
+        /**
+         * @brief get the unwrapped position of the sensor, as estimated by the estimator
+         *
+         * @return Angle
+         */
+        Angle position() const { return estimator.position(); }
+
+        /**
+         * @brief get the velocity of the sensor, as estimated by the estimator
+         *
+         * @return AngularVelocity
+         */
+        AngularVelocity velocity() const { return estimator.velocity(); }
+
+        /**
+         * @brief reset the estimator
+         */
+        void reset() {
+            estimator.reset();
+            lastSample.reset();
+        }
+    private:
+        /**
+         * @brief round a data rate up to the 5ms steps the sensor supports, and to at least 5ms
+         */
+        static constexpr Time roundDataRate(Time dataRate) {
+            return std::max(std::ceil(to_msec(dataRate) / 5 - 1e-9), 1.0) * 5_msec;
+        }
+
+        static constexpr double centidegree = deg.internal() / 100; /** centidegrees to rad */
+        const pros::Rotation& rotation;
+        Estimator estimator;
+        Time minInterval; /** samples closer together than this are skipped. Half the data rate */
+        Timestamp epoch; /** when the first sample was taken */
+        std::optional<Timestamp> lastSample; /** when the latest sample was taken */
+};
+} // namespace units
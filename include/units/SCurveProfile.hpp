@@ -0,0 +1,144 @@
+#pragma once
+
+#include "units/MotionState.hpp"
+#include <span>
+
+namespace units {
+/**
+ * @class SCurveProfile
+ *
+ * @brief a closed form, jerk limited, seven segment motion profile
+ *
+ * The profile starts and ends at rest. Segment durations are solved once on construction, without any iterative
+ * solver, including the degenerate cases where the maximum acceleration and/or the maximum velocity can't be reached.
+ * Sampling is O(1).
+ *
+ * @tparam Q the position quantity type, e.g Length or Angle
+ */
+template <isQuantity Q> class SCurveProfile {
+        using Velocity = Divided<Q, Time>;
+        using Acceleration = Divided<Velocity, Time>;
+        using Jerk = Divided<Acceleration, Time>;
+    public:
+        /**
+         * @brief Construct a new SCurveProfile object
+         *
+         * @param distance the distance to travel, may be negative
+         * @param maxVelocity the maximum velocity
+         * @param maxAcceleration the maximum acceleration
+         * @param maxJerk the maximum jerk
+         */
+        constexpr SCurveProfile(Q distance, Velocity maxVelocity, Acceleration maxAcceleration, Jerk maxJerk)
+            : distance(distance.internal()) {
+            const double s = this->distance < 0 ? -1 : 1;
+            const double d = s * this->distance;
+            const double v = abs(maxVelocity).internal();
+            const double a = abs(maxAcceleration).internal();
+            const double j = abs(maxJerk).internal();
+            // jerk time, constant acceleration time, and constant velocity time
+            double tj = a / j;
+            double ta = v / a - tj;
+            // max acceleration can't be reached before max velocity
+            if (ta < 0) {
+                tj = std::sqrt(v / j);
+                ta = 0;
+            }
+            double peak = j * tj * (tj + ta);
+            // max velocity can't be reached before having to slow down
+            if (peak * (2 * tj + ta) > d) {
+                peak = a * (std::sqrt(a * a / (j * j) + 4 * d / a) - a / j) / 2;
+                tj = a / j;
+                ta = peak / a - tj;
+                // max acceleration can't be reached either
+                if (ta < 0) {
+                    tj = std::cbrt(d / (2 * j));
+                    ta = 0;
+                    peak = j * tj * tj;
+                }
+            }
+            const double tv = peak > 0 ? std::max(d - peak * (2 * tj + ta), 0.0) / peak : 0;
+            const double durations[7] = {tj, ta, tj, tv, tj, ta, tj};
+            const double jerks[7] = {j, 0, -j, 0, -j, 0, j};
+            double t = 0, p = 0, vel = 0, acc = 0;
+            for (std::size_t i = 0; i < 7; i++) {
+                const double dt = durations[i];
+                const double jk = s * jerks[i];
+                segments[i] = {t, p, vel, acc, jk};
+                p += ((jk * dt / 6 + acc / 2) * dt + vel) * dt;
+                vel += (jk * dt / 2 + acc) * dt;
+                acc += jk * dt;
+                t += dt;
+            }
+            end = t;
+        }
+
+        /**
+         * @brief sample the profile
+         *
+         * @param t time since the start of the profile
+         * @return MotionState<Q>
+         */
+        constexpr MotionState<Q> sample(Time t) const {
+            std::size_t i = 6;
+            while (i > 0 && segments[i].t0 > t.internal()) i--;
+            return evaluate(i, t.internal());
+        }
+
+        /**
+         * @brief sample the profile at regular intervals
+         *
+         * Consecutive samples walk the segments forwards instead of searching for them, so filling the whole buffer is
+         * linear in its size.
+         *
+         * @param start the time of the first sample
+         * @param step the time between samples
+         * @param out the buffer to fill
+         */
+        constexpr void sample(Time start, Time step, std::span<MotionState<Q>> out) const {
+            std::size_t i = 0;
+            double t = start.internal();
+            for (MotionState<Q>& state : out) {
+                while (i < 6 && segments[i + 1].t0 <= t) i++;
+                state = evaluate(i, t);
+                t += step.internal();
+            }
+        }
+
+        /**
+         * @brief get the total duration of the profile
+         *
+         * @return Time
+         */
+        constexpr Time duration() const { return Time(end); }
+    private:
+        /**
+         * @brief a constant jerk segment of the profile, in base units
+         */
+        struct Segment {
+                double t0 = 0; /** start time */
+                double p0 = 0; /** start position */
+                double v0 = 0; /** start velocity */
+                double a0 = 0; /** start acceleration */
+                double j = 0; /** jerk */
+        };
+
+        double distance;
+        std::array<Segment, 7> segments {};
+        double end = 0; /** time the last segment ends */
+
+        /**
+         * @brief evaluate a segment of the profile
+         *
+         * @param i the index of the segment
+         * @param t time since the start of the profile
+         * @return MotionState<Q>
+         */
+        constexpr MotionState<Q> evaluate(std::size_t i, double t) const {
+            if (t >= end) return {Q(distance), Velocity(0.0), Acceleration(0.0)};
+            const Segment& seg = segments[i];
+            const double dt = std::max(t - seg.t0, 0.0);
+            return {Q(seg.p0 + ((seg.j * dt / 6 + seg.a0 / 2) * dt + seg.v0) * dt),
+                    Velocity(seg.v0 + (seg.j * dt / 2 + seg.a0) * dt), Acceleration(seg.a0 + seg.j * dt)};
+        }
+};
+} // namespace units
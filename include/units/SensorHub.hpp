@@ -0,0 +1,146 @@
+#pragma once
+
+#include "pros/rtos.hpp"
+#include "units/Published.hpp"
+#include "units/Timestamp.hpp"
+#include "units/units.hpp"
+#include <array>
+#include <functional>
+#include <optional>
+
+namespace units {
+/**
+ * @class SensorHub
+ *
+ * @brief samples every sensor of a robot from one task, and publishes the readings as a single snapshot
+ *
+ * Each sensor is registered with a sampling period and a function that reads it and writes the typed readings into a
+ * Snapshot struct, e.g:
+ * @code
+ * struct Readings {
+ *         ImuSnapshot imu;
+ *         Angle lift = Angle(0.0);
+ * };
+ * SensorHub<Readings> hub(5_msec);
+ * hub.add(10_msec, [&](Timestamp, Readings& r) { r.imu = imuAdapter.update(); });
+ * hub.add(20_msec, [&](Timestamp, Readings& r) { r.lift = liftSensor.position(); });
+ * hub.start();
+ * @endcode
+ *
+ * Every device is then read once per period, no matter how many consumers there are. Sensors that aren't due keep
+ * their previous readings. At the end of every tick the snapshot is published through a Published, so neither the hub
+ * nor its readers take a mutex.
+ *
+ * @tparam Snapshot the readings of every sensor. Must be trivially copyable
+ * @tparam MaxSensors the maximum number of sensors that can be registered
+ */
+template <typename Snapshot, std::size_t MaxSensors = 16> class SensorHub {
+    public:
+        /**
+         * @struct Sample
+         *
+         * @brief a published snapshot
+         */
+        struct Sample {
+                Timestamp time; /** when the tick that published the snapshot started */
+                std::uint32_t tick = 0; /** number of ticks before this one */
+                Snapshot data {}; /** the readings */
+        };
+
+        /**
+         * @brief Construct a new SensorHub object
+         *
+         * @param period how often the hub task runs. Sensors can't be sampled faster than this
+         * @param initial the readings before any sensor has been sampled
+         */
+        SensorHub(Time period, Snapshot initial = {})
+            : period(period),
+              working {Timestamp(), 0, initial},
+              published(working) {}
+
+        SensorHub(const SensorHub&) = delete;
+        SensorHub& operator=(const SensorHub&) = delete;
+
+        /**
+         * @brief register a sensor
+         *
+         * Must be called before start()
+         *
+         * @param period how often to sample the sensor
+         * @param sample reads the sensor, and writes its readings into the snapshot. Called from the hub task
+         * @return true the sensor was registered
+         * @return false MaxSensors sensors are already registered
+         */
+        bool add(Time period, std::function<void(Timestamp, Snapshot&)> sample) {
+            if (count == MaxSensors) return false;
+            sensors[count++] = {std::move(sample), period, Timestamp()};
+            return true;
+        }
+
+        /**
+         * @brief start the hub task
+         *
+         * @param priority priority of the task. Should be higher than any task that uses the readings
+         */
+        void start(std::uint32_t priority = TASK_PRIORITY_DEFAULT + 1) {
+            if (task) return;
+            task.emplace([this] {
+                std::uint32_t now = pros::millis();
+                const std::uint32_t delta = std::max<std::uint32_t>(to_msec(period), 1);
+                while (true) {
+                    sample(Timestamp::now());
+                    pros::Task::delay_until(&now, delta);
+                }
+            }, priority, TASK_STACK_DEPTH_DEFAULT, "SensorHub");
+        }
+
+        /**
+         * @brief stop the hub task
+         */
+        void stop() {
+            if (!task) return;
+            task->remove();
+            task.reset();
+        }
+
+        /**
+         * @brief sample every sensor that is due, and publish the snapshot
+         *
+         * Called by the hub task every period. Can instead be called from a loop of your own, without calling start()
+         *
+         * @param now the current time
+         */
+        void sample(Timestamp now) {
+            for (std::size_t i = 0; i < count; i++) {
+                Sensor& sensor = sensors[i];
+                if (now < sensor.due) continue;
+                sensor.sample(now, working.data);
+                // skip missed samples instead of bursting to catch up
+                sensor.due = sensor.due + sensor.period > now ? sensor.due + sensor.period : now + sensor.period;
+            }
+            working.time = now;
+            published.publish(working);
+            working.tick++;
+        }
+
+        /**
+         * @brief get a consistent copy of the latest snapshot
+         *
+         * @return Sample
+         */
+        Sample read() const { return published.read(); }
+    private:
+        struct Sensor {
+                std::function<void(Timestamp, Snapshot&)> sample;
+                Time period = Time(0.0);
+                Timestamp due; /** when the sensor should next be sampled */
+        };
+
+        Time period;
+        std::array<Sensor, MaxSensors> sensors {};
+        std::size_t count = 0;
+        Sample working; /** only touched by the hub task */
+        Published<Sample> published;
+        std::optional<pros::Task> task;
+};
+} // namespace units
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "units/Vector2D.hpp"
+#include <span>
+#include <vector>
+
+namespace units {
+/**
+ * @class SpatialGrid
+ *
+ * @brief a uniform grid of buckets, for fast radius and nearest neighbour queries on 2D points
+ *
+ * Items are stored sorted by cell in a single contiguous array, with a second array holding where each cell starts,
+ * so there are no per-cell containers. Rebuilding is a counting sort, which is linear in the number of items and cells,
+ * and reuses the memory of the previous build.
+ *
+ * Items that aren't points (e.g line segments) can be indexed by their midpoint, with queries enlarged by half the
+ * length of the longest item.
+ *
+ * @tparam T the type of item stored in the grid
+ */
+template <typename T> class SpatialGrid {
+    public:
+        /**
+         * @brief an item found by a nearest neighbour query
+         */
+        struct Neighbor {
+                const T* item = nullptr; /** the item */
+                Area distanceSquared = Area(0.0); /** squared distance from the query point */
+        };
+
+        /**
+         * @brief Construct a new SpatialGrid object
+         *
+         * Items outside of the bounds are put in the nearest edge cell, so queries still find them
+         *
+         * @param min the minimum corner of the grid
+         * @param max the maximum corner of the grid
+         * @param cellSize the width and height of each cell
+         */
+        SpatialGrid(V2Position min, V2Position max, Length cellSize)
+            : originX(min.x.internal()),
+              originY(min.y.internal()),
+              cell(cellSize.internal()),
+              invCell(1.0 / cellSize.internal()),
+              nx(std::max(static_cast<int>(std::ceil((max.x - min.x).internal() * invCell)), 1)),
+              ny(std::max(static_cast<int>(std::ceil((max.y - min.y).internal() * invCell)), 1)),
+              starts(nx * ny + 1, 0) {}
+
+        /**
+         * @brief replace the contents of the grid
+         *
+         * @param newItems the items to store
+         * @param position a function returning the position of an item. Defaults to converting the item to a
+         * V2Position, which works for V2Position and Pose
+         */
+        template <typename F = V2Position (*)(const T&)>
+        void rebuild(std::span<const T> newItems, F&& position = [](const T& item) { return V2Position(item); }) {
+            const std::size_t n = newItems.size();
+            items.resize(n);
+            xs.resize(n);
+            ys.resize(n);
+            cells.resize(n);
+            std::fill(starts.begin(), starts.end(), 0);
+            for (std::size_t i = 0; i < n; i++) {
+                const V2Position p = position(newItems[i]);
+                cells[i] = cellOf(cellX(p.x.internal()), cellY(p.y.internal()));
+                starts[cells[i] + 1]++;
+            }
+            for (std::size_t c = 1; c < starts.size(); c++) starts[c] += starts[c - 1];
+            // scatter each item to the next free slot of its cell, using the cell starts as cursors
+            for (std::size_t i = 0; i < n; i++) {
+                const std::size_t slot = starts[cells[i]]++;
+                const V2Position p = position(newItems[i]);
+                items[slot] = newItems[i];
+                xs[slot] = p.x.internal();
+                ys[slot] = p.y.internal();
+            }
+            // the cursors now hold the end of each cell, which is the start of the next one
+            for (std::size_t c = starts.size() - 1; c > 0; c--) starts[c] = starts[c - 1];
+            starts[0] = 0;
+        }
+
+        /**
+         * @brief call a function on every item within a radius of a point
+         *
+         * @param center the point to search around
+         * @param radius the search radius
+         * @param f a function taking a const T& and the squared distance to it as an Area
+         */
+        template <typename F> void query(V2Position center, Length radius, F&& f) const {
+            const double cx = center.x.internal();
+            const double cy = center.y.internal();
+            const double r2 = radius.internal() * radius.internal();
+            const int x0 = cellX(cx - radius.internal()), x1 = cellX(cx + radius.internal());
+            const int y0 = cellY(cy - radius.internal()), y1 = cellY(cy + radius.internal());
+            for (int y = y0; y <= y1; y++) {
+                // cells in the same row are contiguous in storage, so the whole row is a single range
+                for (std::size_t i = starts[cellOf(x0, y)]; i < starts[cellOf(x1, y) + 1]; i++) {
+                    const double d2 = (xs[i] - cx) * (xs[i] - cx) + (ys[i] - cy) * (ys[i] - cy);
+                    if (d2 <= r2) f(items[i], Area(d2));
+                }
+            }
+        }
+
+        /**
+         * @brief find the k nearest items to a point
+         *
+         * Searches rings of cells around the point, outwards, until no closer item can be found
+         *
+         * @param center the point to search around
+         * @param out the buffer to write the results to, sorted by distance. k is the size of the buffer
+         * @return std::size_t the number of items found
+         */
+        std::size_t nearest(V2Position center, std::span<Neighbor> out) const {
+            if (out.empty()) return 0;
+            const double cx = center.x.internal();
+            const double cy = center.y.internal();
+            const int ox = cellX(cx), oy = cellY(cy);
+            std::size_t found = 0;
+            for (int ring = 0; ring < std::max(nx, ny); ring++) {
+                // every unvisited cell is at least this far away
+                const double reach = (ring - 1) * cell;
+                if (found == out.size() && ring > 0 && out[found - 1].distanceSquared.internal() <= reach * reach) {
+                    break;
+                }
+                for (int y = std::max(oy - ring, 0); y <= std::min(oy + ring, ny - 1); y++) {
+                    const bool edge = y == oy - ring || y == oy + ring;
+                    const int step = edge ? 1 : 2 * ring;
+                    for (int x = ox - ring; x <= ox + ring; x += step) {
+                        if (x < 0 || x >= nx) continue;
+                        const int c = cellOf(x, y);
+                        for (std::size_t i = starts[c]; i < starts[c + 1]; i++) {
+                            const double d2 = (xs[i] - cx) * (xs[i] - cx) + (ys[i] - cy) * (ys[i] - cy);
+                            if (found == out.size() && d2 >= out[found - 1].distanceSquared.internal()) continue;
+                            // insertion sort into the results
+                            std::size_t j = found < out.size() ? found++ : found - 1;
+                            while (j > 0 && out[j - 1].distanceSquared.internal() > d2) {
+                                out[j] = out[j - 1];
+                                j--;
+                            }
+                            out[j] = {&items[i], Area(d2)};
+                        }
+                    }
+                }
+            }
+            return found;
+        }
+
+        /**
+         * @brief get the number of items in the grid
+         *
+         * @return std::size_t
+         */
+        std::size_t size() const { return items.size(); }
+    private:
+        double originX; /** x coordinate of the minimum corner */
+        double originY; /** y coordinate of the minimum corner */
+        double cell; /** cell size */
+        double invCell; /** reciprocal of the cell size */
+        int nx; /** number of columns */
+        int ny; /** number of rows */
+        std::vector<std::size_t> starts; /** index of the first item of each cell, followed by the total item count */
+        std::vector<T> items; /** items, sorted by cell */
+        std::vector<double> xs; /** x coordinate of each item */
+        std::vector<double> ys; /** y coordinate of each item */
+        std::vector<int> cells; /** scratch space for rebuilding, the cell of each item */
+
+        int cellX(double x) const {
+            return std::clamp(static_cast<int>(std::floor((x - originX) * invCell)), 0, nx - 1);
+        }
+
+        int cellY(double y) const {
+            return std::clamp(static_cast<int>(std::floor((y - originY) * invCell)), 0, ny - 1);
+        }
+
+        int cellOf(int x, int y) const { return y * nx + x; }
+};
+} // namespace units
@@ -0,0 +1,265 @@
+#pragma once
+
+#include "units/Vector2D.hpp"
+#include <span>
+
+namespace units {
+/**
+ * @class PolynomialSpline
+ *
+ * @brief a 2D parametric polynomial curve over Length, with its parameter t going from 0 to 1
+ *
+ * The curve is stored in power basis, so every evaluation is a Horner's method evaluation. Coefficients of the first
+ * and second derivatives are precomputed on construction.
+ *
+ * @tparam Degree the degree of the polynomial, e.g 3 for cubic or 5 for quintic
+ */
+template <std::size_t Degree> class PolynomialSpline {
+        static_assert(Degree >= 1, "PolynomialSpline must be at least linear");
+    public:
+        /**
+         * @brief Construct a new PolynomialSpline object from power basis coefficients
+         *
+         * position(t) = coefficients[0] + coefficients[1] * t + ... + coefficients[Degree] * t^Degree
+         *
+         * @param coefficients the coefficients, in increasing powers of t
+         */
+        constexpr PolynomialSpline(const std::array<V2Position, Degree + 1>& coefficients) {
+            for (std::size_t i = 0; i <= Degree; i++) {
+                x[i] = coefficients[i].x.internal();
+                y[i] = coefficients[i].y.internal();
+            }
+            for (std::size_t i = 0; i < Degree; i++) {
+                dx[i] = x[i + 1] * (i + 1);
+                dy[i] = y[i + 1] * (i + 1);
+            }
+            for (std::size_t i = 0; i + 1 < Degree; i++) {
+                ddx[i] = dx[i + 1] * (i + 1);
+                ddy[i] = dy[i + 1] * (i + 1);
+            }
+        }
+
+        /**
+         * @brief create a cubic hermite spline
+         *
+         * @param p0 start position
+         * @param d0 start derivative
+         * @param p1 end position
+         * @param d1 end derivative
+         * @return PolynomialSpline
+         */
+        constexpr static PolynomialSpline hermite(V2Position p0, V2Position d0, V2Position p1, V2Position d1)
+            requires(Degree == 3)
+        {
+            return PolynomialSpline({p0, d0, p0 * -3.0 + p1 * 3.0 - d0 * 2.0 - d1, p0 * 2.0 - p1 * 2.0 + d0 + d1});
+        }
+
+        /**
+         * @brief create a quintic hermite spline
+         *
+         * @param p0 start position
+         * @param d0 start derivative
+         * @param dd0 start second derivative
+         * @param p1 end position
+         * @param d1 end derivative
+         * @param dd1 end second derivative
+         * @return PolynomialSpline
+         */
+        constexpr static PolynomialSpline hermite(V2Position p0, V2Position d0, V2Position dd0, V2Position p1,
+                                                  V2Position d1, V2Position dd1)
+            requires(Degree == 5)
+        {
+            return PolynomialSpline({p0, d0, dd0 * 0.5,
+                                     p0 * -10.0 - d0 * 6.0 - dd0 * 1.5 + dd1 * 0.5 - d1 * 4.0 + p1 * 10.0,
+                                     p0 * 15.0 + d0 * 8.0 + dd0 * 1.5 - dd1 + d1 * 7.0 - p1 * 15.0,
+                                     p0 * -6.0 - d0 * 3.0 - dd0 * 0.5 + dd1 * 0.5 - d1 * 3.0 + p1 * 6.0});
+        }
+
+        /**
+         * @brief create a bezier curve
+         *
+         * @param points the control points
+         * @return PolynomialSpline
+         */
+        constexpr static PolynomialSpline bezier(const std::array<V2Position, Degree + 1>& points) {
+            // convert from bernstein basis to power basis
+            std::array<V2Position, Degree + 1> coefficients;
+            for (std::size_t j = 0; j <= Degree; j++) {
+                V2Position sum;
+                for (std::size_t i = 0; i <= j; i++) {
+                    const double sign = (j - i) % 2 == 0 ? 1 : -1;
+                    sum += points[i] * (sign * binomial(j, i));
+                }
+                coefficients[j] = sum * binomial(Degree, j);
+            }
+            return PolynomialSpline(coefficients);
+        }
+
+        /**
+         * @brief get the position on the curve
+         *
+         * @param t parameter, from 0 to 1
+         * @return V2Position
+         */
+        constexpr V2Position position(Number t) const {
+            return V2Position(Length(horner(x, t.internal())), Length(horner(y, t.internal())));
+        }
+
+        /**
+         * @brief get the derivative of the curve with respect to its parameter
+         *
+         * @param t parameter, from 0 to 1
+         * @return V2Position
+         */
+        constexpr V2Position derivative(Number t) const {
+            return V2Position(Length(horner(dx, t.internal())), Length(horner(dy, t.internal())));
+        }
+
+        /**
+         * @brief get the second derivative of the curve with respect to its parameter
+         *
+         * @param t parameter, from 0 to 1
+         * @return V2Position
+         */
+        constexpr V2Position secondDerivative(Number t) const {
+            if constexpr (Degree == 1) return V2Position();
+            else return V2Position(Length(horner(ddx, t.internal())), Length(horner(ddy, t.internal())));
+        }
+
+        /**
+         * @brief get the signed curvature of the curve. Positive curvature turns counterclockwise
+         *
+         * @param t parameter, from 0 to 1
+         * @return Curvature
+         */
+        constexpr Curvature curvature(Number t) const {
+            const V2Position d = derivative(t);
+            const V2Position dd = secondDerivative(t);
+            const double speed = std::hypot(d.x.internal(), d.y.internal());
+            return Curvature((d.x.internal() * dd.y.internal() - d.y.internal() * dd.x.internal()) /
+                             (speed * speed * speed));
+        }
+
+        /**
+         * @brief evaluate the positions at many parameters, into separate x and y buffers
+         *
+         * @param ts the parameters
+         * @param xs the buffer to write x coordinates to, at least as long as ts
+         * @param ys the buffer to write y coordinates to, at least as long as ts
+         */
+        constexpr void positions(std::span<const double> ts, std::span<Length> xs, std::span<Length> ys) const {
+            for (std::size_t i = 0; i < ts.size(); i++) {
+                xs[i] = Length(horner(x, ts[i]));
+                ys[i] = Length(horner(y, ts[i]));
+            }
+        }
+
+        /**
+         * @brief evaluate the derivatives at many parameters, into separate x and y buffers
+         *
+         * @param ts the parameters
+         * @param xs the buffer to write x components to, at least as long as ts
+         * @param ys the buffer to write y components to, at least as long as ts
+         */
+        constexpr void derivatives(std::span<const double> ts, std::span<Length> xs, std::span<Length> ys) const {
+            for (std::size_t i = 0; i < ts.size(); i++) {
+                xs[i] = Length(horner(dx, ts[i]));
+                ys[i] = Length(horner(dy, ts[i]));
+            }
+        }
+    private:
+        std::array<double, Degree + 1> x {}; /** x coefficients */
+        std::array<double, Degree + 1> y {}; /** y coefficients */
+        std::array<double, Degree> dx {}; /** x coefficients of the derivative */
+        std::array<double, Degree> dy {}; /** y coefficients of the derivative */
+        std::array<double, (Degree > 1 ? Degree - 1 : 1)> ddx {}; /** x coefficients of the second derivative */
+        std::array<double, (Degree > 1 ? Degree - 1 : 1)> ddy {}; /** y coefficients of the second derivative */
+
+        template <std::size_t N> constexpr static double horner(const std::array<double, N>& c, double t) {
+            double result = c[N - 1];
+            for (std::size_t i = N - 1; i > 0; i--) result = result * t + c[i - 1];
+            return result;
+        }
+
+        constexpr static double binomial(std::size_t n, std::size_t k) {
+            double result = 1;
+            for (std::size_t i = 1; i <= k; i++) result = result * (n - k + i) / i;
+            return result;
+        }
+};
+
+// define some common spline types
+typedef PolynomialSpline<3> CubicSpline;
+typedef PolynomialSpline<5> QuinticSpline;
+
+/**
+ * @class ArcLengthTable
+ *
+ * @brief a table mapping distance along a curve to the curve parameter
+ *
+ * The table is built once by integrating the speed of the curve, and stores the parameter at N + 1 evenly spaced
+ * distances, so looking up the parameter at a distance is O(1).
+ *
+ * @tparam N the number of intervals in the table
+ */
+template <std::size_t N> class ArcLengthTable {
+        static_assert(N >= 1, "ArcLengthTable needs at least 1 interval");
+    public:
+        /**
+         * @brief Construct a new ArcLengthTable object
+         *
+         * @tparam Curve the type of the curve. Must have a derivative(Number t) function
+         * @param curve the curve, parameterized from 0 to 1
+         */
+        template <typename Curve> constexpr ArcLengthTable(const Curve& curve) {
+            // cumulative length at evenly spaced parameters, using 5 point gauss-legendre quadrature per interval
+            constexpr double nodes[5] = {0, -0.5384693101056831, 0.5384693101056831, -0.9061798459386640,
+                                         0.9061798459386640};
+            constexpr double weights[5] = {0.5688888888888889, 0.4786286704993665, 0.4786286704993665,
+                                           0.2369268850561891, 0.2369268850561891};
+            std::array<double, N + 1> lengths {};
+            for (std::size_t i = 0; i < N; i++) {
+                double sum = 0;
+                for (std::size_t k = 0; k < 5; k++) {
+                    const V2Position d = curve.derivative((i + 0.5 + 0.5 * nodes[k]) / N);
+                    sum += weights[k] * std::hypot(d.x.internal(), d.y.internal());
+                }
+                lengths[i + 1] = lengths[i] + sum / (2 * N);
+            }
+            total = lengths[N];
+            invStep = total > 0 ? N / total : 0;
+            // invert, by walking both tables forwards
+            std::size_t j = 0;
+            for (std::size_t i = 0; i <= N; i++) {
+                const double s = total * i / N;
+                while (j + 1 < N && lengths[j + 1] < s) j++;
+                const double span = lengths[j + 1] - lengths[j];
+                const double f = span > 0 ? std::clamp((s - lengths[j]) / span, 0.0, 1.0) : 0;
+                params[i] = (j + f) / N;
+            }
+        }
+
+        /**
+         * @brief get the total length of the curve
+         *
+         * @return Length
+         */
+        constexpr Length length() const { return Length(total); }
+
+        /**
+         * @brief get the curve parameter at a distance along the curve
+         *
+         * @param s distance along the curve, clamped to the curve
+         * @return Number
+         */
+        constexpr Number parameterAt(Length s) const {
+            const double x = std::clamp(s.internal() * invStep, 0.0, static_cast<double>(N));
+            const std::size_t i = std::min(static_cast<std::size_t>(x), N - 1);
+            return params[i] + (params[i + 1] - params[i]) * (x - i);
+        }
+    private:
+        std::array<double, N + 1> params {}; /** parameter at evenly spaced distances */
+        double total = 0; /** total length */
+        double invStep = 0; /** reciprocal of the distance between entries */
+};
+} // namespace units
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <utility>
+
+namespace units {
+// Binary telemetry format
+// This header has no dependencies on PROS, so the decoder can be compiled into tools that run on a computer.
+//
+// Every frame is COBS encoded, and terminated by a 0 byte. Decoded, a frame is a type byte, a channel id byte, and a
+// payload. Multi-byte values are little endian.
+//
+// Metadata frame: type 1, sent once per channel
+//  - 8 dimensions, each an int8 numerator and int8 denominator, in the order of the Quantity template parameters:
+//    mass, length, time, current, angle, temperature, luminosity, moles
+//  - the length of the name, then the name, not null terminated
+//
+// Sample frame: type 2
+//  - uint32 timestamp, the low 32 bits of the microsecond count of the Timestamp, to keep frames small. It wraps every
+//    71.6 minutes, so a reader that logs for longer should unwrap it, which works while consecutive samples are less
+//    than 35.8 minutes apart
+//  - 1 or more float32 values, in the base units of the channel
+
+/**
+ * @brief the type of a telemetry frame
+ */
+enum class TelemetryFrame : std::uint8_t {
+    Metadata = 1, /** describes a channel */
+    Sample = 2, /** timestamped values of a channel */
+};
+
+constexpr std::size_t maxTelemetryValues = 16; /** maximum number of values in a sample frame */
+constexpr std::size_t maxTelemetryName = 32; /** maximum length of a channel name */
+constexpr std::size_t maxTelemetryFrame = 2 + 4 + 4 * maxTelemetryValues; /** maximum size of a decoded frame */
+constexpr std::size_t maxEncodedTelemetryFrame = maxTelemetryFrame + maxTelemetryFrame / 254 + 2; /** with COBS */
+
+/**
+ * @brief COBS encode a frame, and terminate it with a 0 byte
+ *
+ * @param in the frame
+ * @param out buffer for the encoded frame. Must hold at least in.size() + in.size() / 254 + 2 bytes
+ * @return std::size_t the size of the encoded frame, including the terminating 0
+ */
+constexpr std::size_t cobsEncode(std::span<const std::uint8_t> in, std::span<std::uint8_t> out) {
+    std::size_t code = 0; // index of the current code byte
+    std::size_t o = 1;
+    for (std::uint8_t byte : in) {
+        if (byte != 0) out[o++] = byte;
+        if (byte == 0 || o - code == 0xFF) {
+            out[code] = static_cast<std::uint8_t>(o - code);
+            code = o++;
+        }
+    }
+    out[code] = static_cast<std::uint8_t>(o - code);
+    out[o++] = 0;
+    return o;
+}
+
+/**
+ * @brief decode a COBS encoded frame
+ *
+ * @param in the encoded frame, without the terminating 0
+ * @param out buffer for the decoded frame. Must be at least as large as in
+ * @return std::size_t the size of the decoded frame, or 0 if the frame is malformed
+ */
+constexpr std::size_t cobsDecode(std::span<const std::uint8_t> in, std::span<std::uint8_t> out) {
+    std::size_t i = 0, o = 0;
+    while (i < in.size()) {
+        const std::uint8_t code = in[i++];
+        if (code == 0 || i + code - 1 > in.size()) return 0;
+        for (std::uint8_t j = 1; j < code; j++) out[o++] = in[i++];
+        if (code != 0xFF && i < in.size()) out[o++] = 0;
+    }
+    return o;
+}
+
+/**
+ * @struct TelemetryChannelInfo
+ *
+ * @brief the metadata of a telemetry channel
+ */
+struct TelemetryChannelInfo {
+        std::array<std::int8_t, 16> dimensions {}; /** numerator and denominator of each dimension */
+        std::array<char, maxTelemetryName> nameBuffer {};
+        std::uint8_t nameLength = 0;
+        bool known = false; /** whether the metadata of the channel has been received */
+
+        /**
+         * @brief get the name of the channel
+         *
+         * @return std::string_view
+         */
+        std::string_view name() const { return std::string_view(nameBuffer.data(), nameLength); }
+};
+
+/**
+ * @class TelemetryDecoder
+ *
+ * @brief decodes a stream of telemetry frames, e.g on a computer receiving telemetry from a robot
+ *
+ * Bytes can be fed in chunks of any size. Samples from channels whose metadata hasn't been received yet are dropped.
+ */
+class TelemetryDecoder {
+    public:
+        /**
+         * @brief decode a chunk of the stream
+         *
+         * @param bytes the chunk
+         * @param onSample called with (const TelemetryChannelInfo&, std::uint32_t micros, std::span<const float>)
+         * for every complete sample frame
+         */
+        template <typename F> void feed(std::span<const std::uint8_t> bytes, F&& onSample) {
+            for (std::uint8_t byte : bytes) {
+                if (byte != 0) {
+                    // frames that are too long can't be valid, and are dropped when they end
+                    if (size < encoded.size()) encoded[size] = byte;
+                    size++;
+                    continue;
+                }
+                if (size <= encoded.size()) handle(std::span(encoded.data(), size), onSample);
+                size = 0;
+            }
+        }
+
+        /**
+         * @brief get the metadata of a channel
+         *
+         * @param id the id of the channel
+         * @return const TelemetryChannelInfo&
+         */
+        const TelemetryChannelInfo& channel(std::uint8_t id) const { return channels[id]; }
+    private:
+        template <typename F> void handle(std::span<const std::uint8_t> frame, F&& onSample) {
+            std::array<std::uint8_t, maxEncodedTelemetryFrame> decoded {};
+            const std::size_t n = cobsDecode(frame, decoded);
+            if (n < 2) return;
+            TelemetryChannelInfo& info = channels[decoded[1]];
+            if (decoded[0] == static_cast<std::uint8_t>(TelemetryFrame::Metadata) && n >= 19) {
+                std::memcpy(info.dimensions.data(), decoded.data() + 2, 16);
+                info.nameLength = std::min<std::size_t>({decoded[18], n - 19, maxTelemetryName});
+                std::memcpy(info.nameBuffer.data(), decoded.data() + 19, info.nameLength);
+                info.known = true;
+            } else if (decoded[0] == static_cast<std::uint8_t>(TelemetryFrame::Sample) && n >= 10 && info.known) {
+                const std::uint32_t micros = decoded[2] | decoded[3] << 8 | decoded[4] << 16 |
+                                             static_cast<std::uint32_t>(decoded[5]) << 24;
+                std::array<float, maxTelemetryValues> values {};
+                const std::size_t count = std::min((n - 6) / 4, maxTelemetryValues);
+                for (std::size_t i = 0; i < count; i++) {
+                    const std::uint8_t* p = decoded.data() + 6 + 4 * i;
+                    const std::uint32_t bits = p[0] | p[1] << 8 | p[2] << 16 | static_cast<std::uint32_t>(p[3]) << 24;
+                    std::memcpy(&values[i], &bits, 4);
+                }
+                onSample(std::as_const(info), micros, std::span<const float>(values.data(), count));
+            }
+        }
+
+        std::array<TelemetryChannelInfo, 256> channels {};
+        std::array<std::uint8_t, maxEncodedTelemetryFrame> encoded {};
+        std::size_t size = 0; /** bytes received in the current frame */
+};
+} // namespace units
@@ -0,0 +1,227 @@
+#pragma once
+
+#include "pros/error.h"
+#include "pros/serial.hpp"
+#include "units/Telemetry.hpp"
+#include "units/Timestamp.hpp"
+#include <cstdio>
+#include <type_traits>
+
+namespace units {
+/**
+ * @struct TelemetryChannel
+ *
+ * @brief a handle to a channel of a TelemetryWriter, which carries the quantity type of its values
+ */
+template <isQuantity Q> struct TelemetryChannel {
+        std::uint8_t id; /** the id of the channel */
+};
+
+/**
+ * @struct StdoutSink
+ *
+ * @brief writes telemetry to stdout, which goes to the computer over USB
+ *
+ * PROS wraps stdout in its own framing by default. To receive the raw telemetry frames on the computer, disable it
+ * with pros::c::serctl(SERCTL_DISABLE_COBS, nullptr) from pros/apix.h
+ */
+struct StdoutSink {
+        bool operator()(std::span<const std::uint8_t> bytes) const {
+            const bool written = std::fwrite(bytes.data(), 1, bytes.size(), stdout) == bytes.size();
+            std::fflush(stdout);
+            return written;
+        }
+};
+
+/**
+ * @struct SerialSink
+ *
+ * @brief writes telemetry to a smart port in generic serial mode
+ *
+ * A frame is only written if all of it fits in the write buffer of the port. Otherwise it is dropped, instead of being
+ * sent in part, which would also corrupt the frame after it. pros::Serial::write may still write less than it was
+ * given, so it is called until the whole frame is written.
+ */
+struct SerialSink {
+        const pros::Serial& serial; /** the serial port. Must outlive the sink */
+
+        bool operator()(std::span<const std::uint8_t> bytes) const {
+            const std::int32_t size = static_cast<std::int32_t>(bytes.size());
+            if (serial.get_write_free() < size) return false;
+            for (std::int32_t written = 0; written < size;) {
+                const std::int32_t n = serial.write(const_cast<std::uint8_t*>(bytes.data()) + written, size - written);
+                if (n == PROS_ERR || n <= 0) return false;
+                written += n;
+            }
+            return true;
+        }
+};
+
+/**
+ * @class TelemetryWriter
+ *
+ * @brief encodes typed quantities into compact binary telemetry frames
+ *
+ * A sample frame is a channel id, a 32 bit microsecond timestamp, and 32 bit float values, in 12 bytes for a single
+ * value, instead of a line of text. The dimensions and name of each channel are sent once, in a metadata frame before
+ * its first sample. Frames are encoded into a buffer on the stack, and never allocate. The format is described in
+ * Telemetry.hpp, along with TelemetryDecoder, which decodes it.
+ * @code
+ * TelemetryWriter writer((StdoutSink()));
+ * auto x = writer.addChannel<Length>("x");
+ * writer.write(x, Timestamp::now(), pose.x);
+ * @endcode
+ *
+ * @tparam Sink called with a std::span<const std::uint8_t> for every encoded frame, e.g StdoutSink. It may return
+ * false if the frame couldn't be written, which is counted by droppedFrames()
+ * @tparam MaxChannels the maximum number of channels, up to 255
+ */
+template <typename Sink, std::size_t MaxChannels = 32> class TelemetryWriter {
+        // id 255 is left for the invalid channel
+        static_assert(MaxChannels < 256, "channel ids are 1 byte");
+    public:
+        /**
+         * @brief Construct a new TelemetryWriter object
+         *
+         * @param sink where encoded frames are written
+         */
+        TelemetryWriter(Sink sink) : sink(sink) {}
+
+        /**
+         * @brief add a channel
+         *
+         * @tparam Q the quantity type of the values of the channel
+         * @param name the name of the channel, up to 32 characters. Must outlive the writer, e.g a string literal
+         * @return TelemetryChannel<Q> the channel. If MaxChannels channels already exist, the id is MaxChannels, and
+         * writes to it are ignored
+         */
+        template <isQuantity Q> TelemetryChannel<Q> addChannel(const char* name) {
+            if (count == MaxChannels) return {static_cast<std::uint8_t>(MaxChannels)};
+            Channel& channel = channels[count];
+            channel.name = name;
+            channel.dimensions = {static_cast<std::int8_t>(Q::mass::num),
+                                  static_cast<std::int8_t>(Q::mass::den),
+                                  static_cast<std::int8_t>(Q::length::num),
+                                  static_cast<std::int8_t>(Q::length::den),
+                                  static_cast<std::int8_t>(Q::time::num),
+                                  static_cast<std::int8_t>(Q::time::den),
+                                  static_cast<std::int8_t>(Q::current::num),
+                                  static_cast<std::int8_t>(Q::current::den),
+                                  static_cast<std::int8_t>(Q::angle::num),
+                                  static_cast<std::int8_t>(Q::angle::den),
+                                  static_cast<std::int8_t>(Q::temperature::num),
+                                  static_cast<std::int8_t>(Q::temperature::den),
+                                  static_cast<std::int8_t>(Q::luminosity::num),
+                                  static_cast<std::int8_t>(Q::luminosity::den),
+                                  static_cast<std::int8_t>(Q::moles::num),
+                                  static_cast<std::int8_t>(Q::moles::den)};
+            channel.described = false;
+            return {static_cast<std::uint8_t>(count++)};
+        }
+
+        /**
+         * @brief write a sample
+         *
+         * @param channel the channel
+         * @param time when the value was measured
+         * @param value the value
+         */
+        template <isQuantity Q> void write(TelemetryChannel<Q> channel, Timestamp time, Q value) {
+            write(channel, time, std::span<const Q>(&value, 1));
+        }
+
+        /**
+         * @brief write a sample with several values, e.g the components of a vector
+         *
+         * @param channel the channel
+         * @param time when the values were measured
+         * @param values the values. Only the first 16 are written
+         */
+        template <isQuantity Q> void write(TelemetryChannel<Q> channel, Timestamp time, std::span<const Q> values) {
+            if (channel.id >= count) return;
+            if (!channels[channel.id].described) describe(channel.id);
+            std::array<std::uint8_t, maxTelemetryFrame> frame;
+            frame[0] = static_cast<std::uint8_t>(TelemetryFrame::Sample);
+            frame[1] = channel.id;
+            // the frame only keeps the low 32 bits, see Telemetry.hpp
+            putU32(frame.data() + 2, static_cast<std::uint32_t>(time.micros()));
+            const std::size_t n = std::min(values.size(), maxTelemetryValues);
+            for (std::size_t i = 0; i < n; i++) {
+                const float value = static_cast<float>(values[i].internal());
+                std::uint32_t bits;
+                std::memcpy(&bits, &value, 4);
+                putU32(frame.data() + 6 + 4 * i, bits);
+            }
+            send(std::span<const std::uint8_t>(frame.data(), 6 + 4 * n));
+        }
+
+        /**
+         * @brief send the metadata of every channel again, e.g after the computer reconnects
+         */
+        void describeAll() {
+            for (std::size_t i = 0; i < count; i++) describe(i);
+        }
+
+        /**
+         * @brief get the number of frames the sink couldn't write
+         *
+         * @return std::uint32_t
+         */
+        std::uint32_t droppedFrames() const { return dropped; }
+    private:
+        struct Channel {
+                const char* name = "";
+                std::array<std::int8_t, 16> dimensions {};
+                bool described = false; /** whether the metadata has been sent */
+        };
+
+        /**
+         * @brief send the metadata of a channel
+         */
+        void describe(std::size_t id) {
+            Channel& channel = channels[id];
+            std::array<std::uint8_t, maxTelemetryFrame> frame;
+            frame[0] = static_cast<std::uint8_t>(TelemetryFrame::Metadata);
+            frame[1] = static_cast<std::uint8_t>(id);
+            std::memcpy(frame.data() + 2, channel.dimensions.data(), 16);
+            const std::string_view name = std::string_view(channel.name).substr(0, maxTelemetryName);
+            frame[18] = static_cast<std::uint8_t>(name.size());
+            std::memcpy(frame.data() + 19, name.data(), name.size());
+            // if the metadata is dropped, it's sent again before the next sample
+            channel.described = send(std::span<const std::uint8_t>(frame.data(), 19 + name.size()));
+        }
+
+        /**
+         * @brief COBS encode a frame, and write it to the sink
+         *
+         * @return false if the sink couldn't write the frame
+         */
+        bool send(std::span<const std::uint8_t> frame) {
+            std::array<std::uint8_t, maxEncodedTelemetryFrame> encoded;
+            const std::span<const std::uint8_t> bytes(encoded.data(), cobsEncode(frame, encoded));
+            if constexpr (std::is_same_v<std::invoke_result_t<Sink&, std::span<const std::uint8_t>>, bool>) {
+                if (sink(bytes)) return true;
+                dropped++;
+                return false;
+            } else {
+                sink(bytes);
+                return true;
+            }
+        }
+
+        /**
+         * @brief write a 32 bit value in little endian
+         */
+        static void putU32(std::uint8_t* out, std::uint32_t value) {
+            out[0] = value;
+            out[1] = value >> 8;
+            out[2] = value >> 16;
+            out[3] = value >> 24;
+        }
+
+        Sink sink;
+        std::array<Channel, MaxChannels> channels {};
+        std::size_t count = 0;
+        std::uint32_t dropped = 0; /** frames the sink couldn't write */
+};
+} // namespace units
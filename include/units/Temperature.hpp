@@ -21,10 +21,9 @@ template <> struct LookupName<Quantity<std::ratio<0>, std::ratio<0>, std::ratio<
         using Named = Temperature;
 };
 
-inline std::ostream& operator<<(std::ostream& os, const Temperature& quantity) {
-    os << quantity.internal() << " k";
-    return os;
-}
+template <> struct UnitSuffix<Temperature> {
+        static constexpr std::string_view value = " k";
+};
 
 constexpr Temperature kelvin = Temperature(1.0);
 
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "pros/rtos.hpp"
+#include "units/units.hpp"
+#include <compare>
+#include <cstdint>
+
+namespace units {
+/**
+ * @class Timestamp
+ *
+ * @brief a point in time, in integer microseconds since PROS initialized
+ *
+ * Time is a duration. A Timestamp is a point in time: subtracting 2 timestamps gives a Time, and adding a Time to a
+ * Timestamp gives another Timestamp, but timestamps can't be added together.
+ *
+ * Timestamps store the 64 bit microsecond count from pros::micros, so they are as cheap to copy and subtract as the
+ * raw counts, never wrap, and keep full precision no matter how long the program has run. Conversion to floating point
+ * only happens when a difference is converted to a Time.
+ */
+class Timestamp {
+    public:
+        /**
+         * @brief Construct a new Timestamp object
+         *
+         * This constructor initializes the timestamp to when PROS initialized
+         */
+        constexpr Timestamp() : count(0) {}
+
+        /**
+         * @brief Construct a new Timestamp object
+         *
+         * @param micros microseconds since PROS initialized, e.g from pros::micros
+         */
+        explicit constexpr Timestamp(std::uint64_t micros) : count(micros) {}
+
+        /**
+         * @brief get the current time
+         *
+         * @return Timestamp
+         */
+        static Timestamp now() { return Timestamp(pros::micros()); }
+
+        /**
+         * @brief create a timestamp from a millisecond count
+         *
+         * @param millis milliseconds since PROS initialized, e.g from pros::millis
+         * @return Timestamp
+         */
+        constexpr static Timestamp fromMillis(std::uint32_t millis) {
+            return Timestamp(static_cast<std::uint64_t>(millis) * 1000);
+        }
+
+        /**
+         * @brief get the raw microsecond count
+         *
+         * @return std::uint64_t
+         */
+        constexpr std::uint64_t micros() const { return count; }
+
+        /**
+         * @brief get the number of microseconds from another timestamp to this one, without converting to floating
+         * point
+         *
+         * @param other the earlier timestamp
+         * @return std::int64_t negative if other is later than this timestamp
+         */
+        constexpr std::int64_t microsSince(Timestamp other) const {
+            return static_cast<std::int64_t>(count - other.count);
+        }
+
+        /**
+         * @brief - operator overload. Gets the time from another timestamp to this one
+         *
+         * @param other the earlier timestamp
+         * @return Time
+         */
+        constexpr Time operator-(Timestamp other) const { return Time(microsSince(other) * 1e-6); }
+
+        /**
+         * @brief + operator overload. Gets the timestamp a time after this one
+         *
+         * @param time the time to add, rounded to the nearest microsecond
+         * @return Timestamp
+         */
+        constexpr Timestamp operator+(Time time) const { return offset(toMicros(time)); }
+
+        /**
+         * @brief - operator overload. Gets the timestamp a time before this one
+         *
+         * @param time the time to subtract, rounded to the nearest microsecond
+         * @return Timestamp
+         */
+        constexpr Timestamp operator-(Time time) const { return offset(-toMicros(time)); }
+
+        /**
+         * @brief += operator overload. Moves this timestamp later by a time
+         *
+         * @param time the time to add, rounded to the nearest microsecond
+         * @return Timestamp&
+         */
+        constexpr Timestamp& operator+=(Time time) {
+            *this = *this + time;
+            return *this;
+        }
+
+        /**
+         * @brief -= operator overload. Moves this timestamp earlier by a time
+         *
+         * @param time the time to subtract, rounded to the nearest microsecond
+         * @return Timestamp&
+         */
+        constexpr Timestamp& operator-=(Time time) {
+            *this = *this - time;
+            return *this;
+        }
+
+        /**
+         * @brief <=> operator overload. Earlier timestamps compare less than later ones
+         *
+         * @param other the timestamp to compare to
+         * @return std::strong_ordering
+         */
+        constexpr std::strong_ordering operator<=>(const Timestamp& other) const = default;
+    private:
+        std::uint64_t count; /** microseconds since PROS initialized */
+
+        /**
+         * @brief round a time to the nearest microsecond
+         */
+        constexpr static std::int64_t toMicros(Time time) {
+            const double us = time.internal() * 1e6;
+            return static_cast<std::int64_t>(us >= 0 ? us + 0.5 : us - 0.5);
+        }
+
+        /**
+         * @brief get the timestamp a number of microseconds after this one
+         */
+        constexpr Timestamp offset(std::int64_t us) const { return Timestamp(count + static_cast<std::uint64_t>(us)); }
+};
+
+/**
+ * @brief + operator overload. Gets the timestamp a time after another
+ *
+ * @param lhs the time to add
+ * @param rhs the timestamp
+ * @return Timestamp
+ */
+constexpr Timestamp operator+(Time lhs, Timestamp rhs) { return rhs + lhs; }
+} // namespace units
@@ -0,0 +1,209 @@
+#pragma once
+
+#include "units/Pose.hpp"
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace units {
+/**
+ * @struct TrajectorySample
+ *
+ * @brief the state of a trajectory at a point in time
+ */
+struct TrajectorySample {
+        Pose pose; /** position and orientation */
+        VelocityPose velocity; /** linear and angular velocity */
+};
+
+/**
+ * @class TrajectoryTable
+ *
+ * @brief a trajectory sampled at a fixed timestep, compact enough to be generated at compile time and kept in flash
+ *
+ * Each of the 6 channels (x, y, orientation, and their velocities) is stored in its own contiguous array. Sampling is a
+ * single multiply to find the index, followed by a linear interpolation. Samples can be stored as floats, or quantized
+ * to integers (e.g int16_t), in which case each channel is scaled to the full range of the integer type.
+ *
+ * Orientations are interpolated without wrapping, so they should be continuous (unwrapped) across the trajectory.
+ *
+ * @tparam N the number of samples
+ * @tparam T the storage type of each sample, either a floating point or an integer type
+ */
+template <std::size_t N, typename T = float> class TrajectoryTable {
+        static_assert(N >= 2, "TrajectoryTable needs at least 2 samples");
+        static_assert(std::is_arithmetic_v<T>, "TrajectoryTable storage must be an arithmetic type");
+    public:
+        /**
+         * @brief Construct a new TrajectoryTable object from already encoded data
+         *
+         * This is the constructor used by tables generated ahead of time on a host computer
+         *
+         * @param dt the time between samples
+         * @param data the encoded samples of each channel
+         * @param scale the scale of each channel. Decoded values are offset + scale * encoded value
+         * @param offset the offset of each channel
+         */
+        constexpr TrajectoryTable(Time dt, const std::array<std::array<T, N>, 6>& data,
+                                  const std::array<double, 6>& scale, const std::array<double, 6>& offset)
+            : dt(dt.internal()),
+              invDt(1.0 / dt.internal()),
+              data(data),
+              scale(scale),
+              offset(offset) {}
+
+        /**
+         * @brief generate a TrajectoryTable by sampling a function at a fixed timestep
+         *
+         * Can be evaluated at compile time if the function is constexpr, e.g
+         * constexpr auto table = TrajectoryTable<200>::generate(10_msec, [](Time t) { ... });
+         *
+         * @param dt the time between samples
+         * @param f a function taking a Time and returning a TrajectorySample
+         * @return TrajectoryTable
+         */
+        template <typename F> constexpr static TrajectoryTable generate(Time dt, F&& f) {
+            std::array<std::array<double, N>, 6> values {};
+            for (std::size_t i = 0; i < N; i++) {
+                const TrajectorySample s = f(dt * static_cast<double>(i));
+                values[0][i] = s.pose.x.internal();
+                values[1][i] = s.pose.y.internal();
+                values[2][i] = s.pose.orientation.internal();
+                values[3][i] = s.velocity.x.internal();
+                values[4][i] = s.velocity.y.internal();
+                values[5][i] = s.velocity.orientation.internal();
+            }
+            return encode(dt, values);
+        }
+
+        /**
+         * @brief create a TrajectoryTable from samples taken at a fixed timestep
+         *
+         * @param dt the time between samples
+         * @param samples the samples
+         * @return TrajectoryTable
+         */
+        constexpr static TrajectoryTable fromSamples(Time dt, const std::array<TrajectorySample, N>& samples) {
+            return generate(dt, [&](Time t) { return samples[index(t.internal() / dt.internal())]; });
+        }
+
+        /**
+         * @brief get the pose at a given time
+         *
+         * @param t time since the start of the trajectory, clamped to the trajectory
+         * @return Pose
+         */
+        constexpr Pose pose(Time t) const {
+            const auto [i, f] = locate(t);
+            return Pose(Length(lerp(0, i, f)), Length(lerp(1, i, f)), Angle(lerp(2, i, f)));
+        }
+
+        /**
+         * @brief get the velocity at a given time
+         *
+         * @param t time since the start of the trajectory, clamped to the trajectory
+         * @return VelocityPose
+         */
+        constexpr VelocityPose velocity(Time t) const {
+            const auto [i, f] = locate(t);
+            return VelocityPose(LinearVelocity(lerp(3, i, f)), LinearVelocity(lerp(4, i, f)),
+                                AngularVelocity(lerp(5, i, f)));
+        }
+
+        /**
+         * @brief get the pose and velocity at a given time
+         *
+         * @param t time since the start of the trajectory, clamped to the trajectory
+         * @return TrajectorySample
+         */
+        constexpr TrajectorySample sample(Time t) const {
+            const auto [i, f] = locate(t);
+            return {Pose(Length(lerp(0, i, f)), Length(lerp(1, i, f)), Angle(lerp(2, i, f))),
+                    VelocityPose(LinearVelocity(lerp(3, i, f)), LinearVelocity(lerp(4, i, f)),
+                                 AngularVelocity(lerp(5, i, f)))};
+        }
+
+        /**
+         * @brief get the total duration of the trajectory
+         *
+         * @return Time
+         */
+        constexpr Time duration() const { return Time(dt * (N - 1)); }
+
+        /**
+         * @brief get the encoded samples, e.g to write a table generated on a host computer to a header file
+         *
+         * @return const std::array<std::array<T, N>, 6>&
+         */
+        constexpr const std::array<std::array<T, N>, 6>& encoded() const { return data; }
+
+        /**
+         * @brief get the scale of each channel
+         *
+         * @return const std::array<double, 6>&
+         */
+        constexpr const std::array<double, 6>& channelScale() const { return scale; }
+
+        /**
+         * @brief get the offset of each channel
+         *
+         * @return const std::array<double, 6>&
+         */
+        constexpr const std::array<double, 6>& channelOffset() const { return offset; }
+    private:
+        double dt; /** time between samples, in seconds */
+        double invDt; /** reciprocal of dt */
+        std::array<std::array<T, N>, 6> data; /** encoded samples of each channel */
+        std::array<double, 6> scale; /** decoded = offset + scale * encoded */
+        std::array<double, 6> offset;
+
+        constexpr static std::size_t index(double i) {
+            return i <= 0 ? 0 : std::min(static_cast<std::size_t>(i + 0.5), N - 1);
+        }
+
+        /**
+         * @brief encode channels stored as doubles into the storage type
+         */
+        constexpr static TrajectoryTable encode(Time dt, const std::array<std::array<double, N>, 6>& values) {
+            std::array<std::array<T, N>, 6> packed {};
+            std::array<double, 6> scale {};
+            std::array<double, 6> offset {};
+            for (std::size_t c = 0; c < 6; c++) {
+                if constexpr (std::is_floating_point_v<T>) {
+                    scale[c] = 1;
+                    for (std::size_t i = 0; i < N; i++) packed[c][i] = static_cast<T>(values[c][i]);
+                } else {
+                    // map the range of the channel to the full range of the integer type
+                    const auto [lo, hi] = std::minmax_element(values[c].begin(), values[c].end());
+                    constexpr double tMin = static_cast<double>(std::numeric_limits<T>::min());
+                    constexpr double tMax = static_cast<double>(std::numeric_limits<T>::max());
+                    scale[c] = *hi > *lo ? (*hi - *lo) / (tMax - tMin) : 1;
+                    offset[c] = *lo - tMin * scale[c];
+                    for (std::size_t i = 0; i < N; i++) {
+                        const double q = std::clamp((values[c][i] - offset[c]) / scale[c], tMin, tMax);
+                        packed[c][i] = static_cast<T>(q >= 0 ? q + 0.5 : q - 0.5);
+                    }
+                }
+            }
+            return TrajectoryTable(dt, packed, scale, offset);
+        }
+
+        /**
+         * @brief find the sample before a given time, and how far the time is between it and the next sample
+         */
+        constexpr std::pair<std::size_t, double> locate(Time t) const {
+            const double x = std::clamp(t.internal() * invDt, 0.0, static_cast<double>(N - 1));
+            const std::size_t i = std::min(static_cast<std::size_t>(x), N - 2);
+            return {i, x - i};
+        }
+
+        /**
+         * @brief decode and linearly interpolate a channel
+         */
+        constexpr double lerp(std::size_t c, std::size_t i, double f) const {
+            const double a = data[c][i];
+            const double b = data[c][i + 1];
+            return offset[c] + scale[c] * (a + (b - a) * f);
+        }
+};
+} // namespace units
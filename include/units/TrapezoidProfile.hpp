@@ -0,0 +1,150 @@
+#pragma once
+
+#include "units/MotionState.hpp"
+
+namespace units {
+/**
+ * @class TrapezoidProfile
+ *
+ * @brief a closed form trapezoidal motion profile
+ *
+ * The profile is planned once on construction, and stored as a short list of constant acceleration segments. Sampling
+ * is O(1), and doesn't need any square roots. The profile may start from a moving state, in which case it may first
+ * have to slow down, or stop and come back if the goal can't be reached without overshooting.
+ *
+ * @tparam Q the position quantity type, e.g Length or Angle
+ */
+template <isQuantity Q> class TrapezoidProfile {
+        using Velocity = Divided<Q, Time>;
+        using Acceleration = Divided<Velocity, Time>;
+    public:
+        /**
+         * @brief Construct a new TrapezoidProfile object
+         *
+         * The profile starts at rest at 0, and ends at rest at the given distance
+         *
+         * @param distance the distance to travel
+         * @param maxVelocity the maximum velocity
+         * @param maxAcceleration the maximum acceleration
+         */
+        constexpr TrapezoidProfile(Q distance, Velocity maxVelocity, Acceleration maxAcceleration)
+            : TrapezoidProfile(MotionState<Q>(), distance, maxVelocity, maxAcceleration) {}
+
+        /**
+         * @brief Construct a new TrapezoidProfile object
+         *
+         * @param start the state to start from. Its acceleration is ignored
+         * @param goal the position to end at
+         * @param maxVelocity the maximum velocity
+         * @param maxAcceleration the maximum acceleration
+         * @param goalVelocity the velocity to end with, in the direction of travel. Defaults to 0
+         */
+        constexpr TrapezoidProfile(MotionState<Q> start, Q goal, Velocity maxVelocity, Acceleration maxAcceleration,
+                                   Velocity goalVelocity = Velocity(0.0))
+            : vMax(abs(maxVelocity).internal()),
+              aMax(abs(maxAcceleration).internal()),
+              goal(goal.internal()),
+              goalVelocity(goalVelocity.internal()) {
+            double p = start.position.internal();
+            double v = start.velocity.internal();
+            const double s = this->goal < p || (this->goal == p && v < 0) ? -1 : 1;
+            const double u0 = s * v;
+            const double uf = std::clamp(s * this->goalVelocity, 0.0, vMax);
+            // too fast to stop in time, so stop past the goal and then come back
+            if (u0 > 0 && u0 * u0 - uf * uf > 2 * aMax * s * (this->goal - p)) {
+                push(p, v, -s * aMax, u0 / aMax);
+                p += s * u0 * u0 / (2 * aMax);
+                v = 0;
+            }
+            plan(p, v);
+        }
+
+        /**
+         * @brief sample the profile
+         *
+         * @param t time since the start of the profile
+         * @return MotionState<Q>
+         */
+        constexpr MotionState<Q> sample(Time t) const {
+            const double time = t.internal();
+            if (time >= end) return {Q(goal), Velocity(goalVelocity), Acceleration(0.0)};
+            std::size_t i = count - 1;
+            while (i > 0 && segments[i].t0 > time) i--;
+            const Segment& seg = segments[i];
+            const double dt = std::max(time - seg.t0, 0.0);
+            return {Q(seg.p0 + (seg.v0 + 0.5 * seg.a * dt) * dt), Velocity(seg.v0 + seg.a * dt), Acceleration(seg.a)};
+        }
+
+        /**
+         * @brief get the total duration of the profile
+         *
+         * @return Time
+         */
+        constexpr Time duration() const { return Time(end); }
+
+        /**
+         * @brief plan a new profile to a different goal, starting from the state of this profile at a given time
+         *
+         * Time in the new profile starts from 0 at the given time
+         *
+         * @param t time since the start of this profile
+         * @param newGoal the position to end at
+         * @return TrapezoidProfile
+         */
+        constexpr TrapezoidProfile retarget(Time t, Q newGoal) const {
+            return TrapezoidProfile(sample(t), newGoal, Velocity(vMax), Acceleration(aMax), Velocity(goalVelocity));
+        }
+    private:
+        /**
+         * @brief a constant acceleration segment of the profile, in base units
+         */
+        struct Segment {
+                double t0 = 0; /** start time */
+                double p0 = 0; /** start position */
+                double v0 = 0; /** start velocity */
+                double a = 0; /** acceleration */
+        };
+
+        double vMax;
+        double aMax;
+        double goal;
+        double goalVelocity;
+        std::array<Segment, 4> segments {};
+        std::size_t count = 0;
+        double end = 0; /** time the last segment ends */
+
+        /**
+         * @brief add a segment to the end of the profile
+         */
+        constexpr void push(double p0, double v0, double a, double duration) {
+            segments[count++] = {end, p0, v0, a};
+            end += duration;
+        }
+
+        /**
+         * @brief plan the accelerate, cruise, and decelerate segments from a state that can reach the goal
+         */
+        constexpr void plan(double p, double v) {
+            const double s = goal < p || (goal == p && v < 0) ? -1 : 1;
+            const double dist = s * (goal - p);
+            const double u0 = s * v;
+            // the goal velocity may be out of reach even accelerating the whole way, then the profile is one ramp
+            const double uf = std::min(std::clamp(s * goalVelocity, 0.0, vMax), std::sqrt(u0 * u0 + 2 * aMax * dist));
+            double peak = vMax;
+            double a1 = peak >= u0 ? aMax : -aMax;
+            double d1 = (peak * peak - u0 * u0) / (2 * a1);
+            double d3 = (peak * peak - uf * uf) / (2 * aMax);
+            // not enough room to reach max velocity, so the profile is a triangle
+            if (d1 + d3 > dist) {
+                peak = std::sqrt(aMax * dist + (u0 * u0 + uf * uf) / 2);
+                a1 = aMax;
+                d1 = (peak * peak - u0 * u0) / (2 * aMax);
+                d3 = (peak * peak - uf * uf) / (2 * aMax);
+            }
+            push(p, v, s * a1, std::abs(peak - u0) / aMax);
+            push(p + s * d1, s * peak, 0, peak > 0 ? std::max(dist - d1 - d3, 0.0) / peak : 0);
+            push(p + s * (dist - d3), s * peak, -s * aMax, (peak - uf) / aMax);
+            goalVelocity = s * uf;
+        }
+};
+} // namespace units
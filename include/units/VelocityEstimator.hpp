@@ -0,0 +1,152 @@
+#pragma once
+
+#include "units/units.hpp"
+#include <array>
+
+namespace units {
+/**
+ * @class LinearFitEstimator
+ *
+ * @brief estimates velocity from the slope of a least squares line through the last N timestamped samples
+ *
+ * Fitting a line through several samples averages out quantization noise, at the cost of N / 2 samples of delay.
+ * Samples are kept in a fixed size ring buffer, so adding a sample never allocates.
+ *
+ * @tparam Q the quantity type of the samples, e.g Angle
+ * @tparam N the number of samples in the window
+ */
+template <isQuantity Q, std::size_t N> class LinearFitEstimator {
+        static_assert(N >= 2, "a line needs at least 2 samples");
+    public:
+        /**
+         * @brief add a sample
+         *
+         * @param time when the sample was taken. Must be later than the previous sample
+         * @param value the value of the sample
+         */
+        constexpr void add(Time time, Q value) {
+            times[head] = time.internal();
+            values[head] = value.internal();
+            head = (head + 1) % N;
+            if (count < N) count++;
+        }
+
+        /**
+         * @brief get the latest sample
+         *
+         * @return Q
+         */
+        constexpr Q position() const { return Q(values[(head + N - 1) % N]); }
+
+        /**
+         * @brief get the estimated velocity
+         *
+         * @return Divided<Q, Time> 0 if there are less than 2 samples
+         */
+        constexpr Divided<Q, Time> velocity() const {
+            if (count < 2) return Divided<Q, Time>(0.0);
+            // times are taken relative to the latest sample to keep precision when the clock is large
+            const double t0 = times[(head + N - 1) % N];
+            double sumT = 0, sumV = 0;
+            for (std::size_t i = 0; i < count; i++) {
+                sumT += times[i] - t0;
+                sumV += values[i];
+            }
+            const double meanT = sumT / count;
+            const double meanV = sumV / count;
+            double num = 0, den = 0;
+            for (std::size_t i = 0; i < count; i++) {
+                const double dt = times[i] - t0 - meanT;
+                num += dt * (values[i] - meanV);
+                den += dt * dt;
+            }
+            return Divided<Q, Time>(den > 0 ? num / den : 0.0);
+        }
+
+        /**
+         * @brief remove every sample
+         */
+        constexpr void reset() {
+            head = 0;
+            count = 0;
+        }
+    private:
+        std::array<double, N> times {};
+        std::array<double, N> values {};
+        std::size_t head = 0; /** index the next sample is written to */
+        std::size_t count = 0; /** number of samples in the window */
+};
+
+/**
+ * @class AlphaBetaEstimator
+ *
+ * @brief estimates position and velocity with an alpha-beta filter
+ *
+ * Each sample, the position is predicted from the previous estimate, and the error of the prediction is fed back into
+ * the position and velocity by alpha and beta. Lower gains reject more noise, but respond slower. It needs no history,
+ * and adapts to uneven sample times.
+ *
+ * @tparam Q the quantity type of the samples, e.g Angle
+ */
+template <isQuantity Q> class AlphaBetaEstimator {
+    public:
+        /**
+         * @brief Construct a new AlphaBetaEstimator object
+         *
+         * @param alpha position gain, between 0 and 1
+         * @param beta velocity gain, between 0 and 2, and usually much smaller than alpha
+         */
+        constexpr AlphaBetaEstimator(Number alpha, Number beta) : alpha(alpha.internal()), beta(beta.internal()) {}
+
+        /**
+         * @brief add a sample
+         *
+         * @param time when the sample was taken. Must be later than the previous sample
+         * @param value the value of the sample
+         */
+        constexpr void add(Time time, Q value) {
+            if (first) {
+                x = value.internal();
+                first = false;
+            } else {
+                const double dt = time.internal() - prevTime;
+                if (dt <= 0) return;
+                x += v * dt;
+                const double r = value.internal() - x;
+                x += alpha * r;
+                v += beta * r / dt;
+            }
+            prevTime = time.internal();
+        }
+
+        /**
+         * @brief get the estimated position
+         *
+         * @return Q
+         */
+        constexpr Q position() const { return Q(x); }
+
+        /**
+         * @brief get the estimated velocity
+         *
+         * @return Divided<Q, Time>
+         */
+        constexpr Divided<Q, Time> velocity() const { return Divided<Q, Time>(v); }
+
+        /**
+         * @brief reset the estimate
+         */
+        constexpr void reset() {
+            x = 0;
+            v = 0;
+            first = true;
+        }
+    private:
+        double alpha;
+        double beta;
+        double x = 0; /** position estimate */
+        double v = 0; /** velocity estimate */
+        double prevTime = 0;
+        bool first = true;
+};
+} // namespace units
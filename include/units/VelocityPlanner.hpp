@@ -0,0 +1,106 @@
+#pragma once
+
+#include "units/units.hpp"
+#include <span>
+
+namespace units {
+/**
+ * @class VelocityPlanner
+ *
+ * @brief computes the fastest velocity at each point of a path, given velocity, acceleration, and centripetal limits
+ *
+ * The path is passed as separate buffers (distance along the path, and curvature, at each point), and results are
+ * written to buffers provided by the caller, so planning never allocates. Planning happens in 3 passes:
+ * 1. a curvature pass, limiting each point independently (branchless, so it can be vectorized)
+ * 2. a forward pass, limiting acceleration
+ * 3. a backward pass, limiting deceleration
+ *
+ * The result of the first 2 passes is kept in its own buffer, so new points can be appended to the path and planned
+ * without replanning the whole path.
+ */
+class VelocityPlanner {
+    public:
+        /**
+         * @brief Construct a new VelocityPlanner object
+         *
+         * @param maxVelocity the maximum velocity
+         * @param maxAcceleration the maximum acceleration and deceleration along the path
+         * @param maxCentripetal the maximum centripetal acceleration
+         */
+        constexpr VelocityPlanner(LinearVelocity maxVelocity, LinearAcceleration maxAcceleration,
+                                  LinearAcceleration maxCentripetal)
+            : maxVelocity(maxVelocity.internal()),
+              maxAcceleration(maxAcceleration.internal()),
+              maxCentripetal(maxCentripetal.internal()) {}
+
+        /**
+         * @brief plan the velocity of every point on a path, or of the points appended to an already planned path
+         *
+         * @param distances distance along the path of each point, increasing
+         * @param curvatures curvature of the path at each point
+         * @param limits buffer for the velocity limit of each point from the curvature and forward passes. Must be
+         * kept unmodified between incremental calls
+         * @param velocities buffer for the planned velocity of each point
+         * @param startVelocity the velocity at the first point
+         * @param endVelocity the velocity at the last point
+         * @param from the number of points that were already planned, and haven't changed since. 0 plans the whole path
+         * @return std::size_t the index of the first point whose planned velocity changed
+         */
+        constexpr std::size_t plan(std::span<const Length> distances, std::span<const Curvature> curvatures,
+                                   std::span<LinearVelocity> limits, std::span<LinearVelocity> velocities,
+                                   LinearVelocity startVelocity, LinearVelocity endVelocity,
+                                   std::size_t from = 0) const {
+            const std::size_t n = distances.size();
+            if (n == 0 || from >= n) return n;
+            // curvature pass
+            for (std::size_t i = from; i < n; i++) {
+                const double k = std::abs(curvatures[i].internal());
+                limits[i] = LinearVelocity(std::min(maxVelocity, std::sqrt(maxCentripetal / k)));
+            }
+            // forward pass
+            if (from == 0) limits[0] = units::min(limits[0], startVelocity);
+            for (std::size_t i = std::max(from, std::size_t(1)); i < n; i++) {
+                const double v = limits[i - 1].internal();
+                const double ds = (distances[i] - distances[i - 1]).internal();
+                limits[i] = LinearVelocity(std::min(limits[i].internal(), std::sqrt(v * v + 2 * maxAcceleration * ds)));
+            }
+            // backward pass. Points that were already planned stop being updated once they stop changing
+            velocities[n - 1] = units::min(limits[n - 1], endVelocity);
+            std::size_t i = n - 1;
+            while (i > 0) {
+                const double v = velocities[i].internal();
+                const double ds = (distances[i] - distances[i - 1]).internal();
+                const LinearVelocity next =
+                    LinearVelocity(std::min(limits[i - 1].internal(), std::sqrt(v * v + 2 * maxAcceleration * ds)));
+                if (i - 1 < from && next == velocities[i - 1]) break;
+                velocities[--i] = next;
+            }
+            return i;
+        }
+
+        /**
+         * @brief compute the time at which each point of a planned path is reached
+         *
+         * Assumes constant acceleration between points
+         *
+         * @param distances distance along the path of each point, increasing
+         * @param velocities the planned velocity of each point
+         * @param times buffer for the time of each point
+         * @param from the first point to compute the time of, e.g the index returned by plan()
+         */
+        constexpr void timestamps(std::span<const Length> distances, std::span<const LinearVelocity> velocities,
+                                  std::span<Time> times, std::size_t from = 0) const {
+            if (distances.empty()) return;
+            if (from == 0) times[0] = Time(0.0);
+            for (std::size_t i = std::max(from, std::size_t(1)); i < distances.size(); i++) {
+                const double ds = (distances[i] - distances[i - 1]).internal();
+                const double sum = (velocities[i - 1] + velocities[i]).internal();
+                times[i] = times[i - 1] + Time(sum > 0 ? 2 * ds / sum : 0);
+            }
+        }
+    private:
+        double maxVelocity;
+        double maxAcceleration;
+        double maxCentripetal;
+};
+} // namespace units
@@ -3,7 +3,7 @@
 #include <array>
 #include <cmath>
 #include <ratio>
-#include <iostream>
+#include <string_view>
 #include <utility>
 #include <algorithm>
 
@@ -58,7 +58,7 @@ class Quantity {
          *
          * @param other the quantity to copy
          */
-        constexpr Quantity(Self const& other) : value(other.value) {}
+        constexpr Quantity(Self const& other) = default;
 
         /**
          * @brief get the value of the quantity in its base unit type
@@ -167,37 +167,74 @@ template <isQuantity Q, typename quotient> using Rooted = Named<
              std::ratio_divide<typename Q::angle, quotient>, std::ratio_divide<typename Q::temperature, quotient>,
              std::ratio_divide<typename Q::luminosity, quotient>, std::ratio_divide<typename Q::moles, quotient>>>;
 
-inline void unit_printer_helper(std::ostream& os, double quantity,
-                                const std::array<std::pair<intmax_t, intmax_t>, 8>& dims) {
-    static constinit std::array<const char*, 8> prefixes {"_kg", "_m", "_s", "_A", "_rad", "_K", "_cd", "_mol"};
-    os << quantity;
+/**
+ * @brief the text printed after the value of a quantity, built at compile time
+ */
+struct UnitSuffixText {
+        std::array<char, 96> text {};
+        std::size_t length = 0;
+
+        constexpr void append(char c) { text[length++] = c; }
+
+        constexpr void append(const char* s) {
+            while (*s) append(*s++);
+        }
+
+        constexpr void append(intmax_t n) {
+            if (n < 0) append('-');
+            std::array<char, 20> digits {};
+            std::size_t count = 0;
+            do {
+                digits[count++] = static_cast<char>('0' + (n < 0 ? -(n % 10) : n % 10));
+                n /= 10;
+            } while (n != 0);
+            while (count != 0) append(digits[--count]);
+        }
+
+        constexpr std::string_view view() const { return std::string_view(text.data(), length); }
+};
+
+/**
+ * @brief build the suffix of a quantity without a name from its dimensions, e.g "_m^2_s^-1"
+ */
+template <isQuantity Q> constexpr UnitSuffixText dimensionSuffix() {
+    const std::array<std::pair<intmax_t, intmax_t>, 8> dims {{
+        {Q::mass::num, Q::mass::den},
+        {Q::length::num, Q::length::den},
+        {Q::time::num, Q::time::den},
+        {Q::current::num, Q::current::den},
+        {Q::angle::num, Q::angle::den},
+        {Q::temperature::num, Q::temperature::den},
+        {Q::luminosity::num, Q::luminosity::den},
+        {Q::moles::num, Q::moles::den},
+    }};
+    const std::array<const char*, 8> prefixes {"_kg", "_m", "_s", "_A", "_rad", "_K", "_cd", "_mol"};
+    UnitSuffixText out;
     for (size_t i = 0; i != 8; i++) {
         if (dims[i].first != 0) {
-            os << prefixes[i];
-            if (dims[i].first != 1 || dims[i].second != 1) os << '^' << dims[i].first;
-            if (dims[i].second != 1) os << '/' << dims[i].second;
+            out.append(prefixes[i]);
+            if (dims[i].first != 1 || dims[i].second != 1) {
+                out.append('^');
+                out.append(dims[i].first);
+            }
+            if (dims[i].second != 1) {
+                out.append('/');
+                out.append(dims[i].second);
+            }
         }
     }
+    return out;
 }
 
-template <isQuantity Q> inline std::ostream& operator<<(std::ostream& os, const Q& quantity) {
-    if constexpr (!std::is_same_v<Named<Q>, Q>) {
-        os << Named<Q>(quantity);
-    } else {
-        constinit static std::array<std::pair<intmax_t, intmax_t>, 8> dims {{
-            {Q::mass::num, Q::mass::den},
-            {Q::length::num, Q::length::den},
-            {Q::time::num, Q::time::den},
-            {Q::current::num, Q::current::den},
-            {Q::angle::num, Q::angle::den},
-            {Q::temperature::num, Q::temperature::den},
-            {Q::luminosity::num, Q::luminosity::den},
-            {Q::moles::num, Q::moles::den},
-        }};
-        unit_printer_helper(os, quantity.internal(), dims);
-    }
-    return os;
-}
+/**
+ * @brief the text printed after the value of a quantity
+ *
+ * Quantities without a name are printed with their dimensions. Named units specialize this with their suffix.
+ */
+template <typename Q> struct UnitSuffix {
+        static constexpr UnitSuffixText text = dimensionSuffix<Q>();
+        static constexpr std::string_view value = text.view();
+};
 
 template <isQuantity Q> constexpr Q operator+(Q rhs) { return rhs; }
 
@@ -291,10 +328,9 @@ template <isQuantity Q, isQuantity R> constexpr bool operator>(const Q& lhs, con
         return Name(Quantity<std::ratio<m>, std::ratio<l>, std::ratio<t>, std::ratio<i>, std::ratio<a>, std::ratio<o>, \
                              std::ratio<j>, std::ratio<n>>(static_cast<double>(value)));                               \
     }                                                                                                                  \
-    inline std::ostream& operator<<(std::ostream& os, const Name& quantity) {                                          \
-        os << quantity.internal() << " " << #suffix;                                                                   \
-        return os;                                                                                                     \
-    }                                                                                                                  \
+    template <> struct UnitSuffix<Name> {                                                                              \
+            static constexpr std::string_view value = " " #suffix;                                                     \
+    };                                                                                                                 \
     constexpr inline Name from_##suffix(double value) { return Name(value); }                                          \
     constexpr inline Name from_##suffix(Number value) { return Name(value.internal()); }                               \
     constexpr inline double to_##suffix(Name quantity) { return quantity.internal(); }
@@ -348,10 +384,9 @@ constexpr Number operator""_num(unsigned long long value) {
                            std::ratio<0>, std::ratio<0>>(static_cast<double>(value)));
 }
 
-inline std::ostream& operator<<(std::ostream& os, const Number& quantity) {
-    os << quantity.internal() << " " << num;
-    return os;
-}
+template <> struct UnitSuffix<Number> {
+        static constexpr std::string_view value = "";
+};
 
 constexpr inline Number from_num(double value) { return Number(value); }
 
@@ -524,8 +559,9 @@ template <isQuantity Q, isQuantity R> constexpr Q round(const Q& lhs, const R& r
 
 // Convert an angular unit `Q` to a linear unit correctly;
 // mostly useful for velocities
-template <isQuantity Q> Quantity<typename Q::mass, typename Q::angle, typename Q::time, typename Q::current,
-                                 typename Q::length, typename Q::temperature, typename Q::luminosity, typename Q::moles>
+template <isQuantity Q>
+constexpr Quantity<typename Q::mass, typename Q::angle, typename Q::time, typename Q::current, typename Q::length,
+                   typename Q::temperature, typename Q::luminosity, typename Q::moles>
 toLinear(Quantity<typename Q::mass, typename Q::length, typename Q::time, typename Q::current, typename Q::angle,
                   typename Q::temperature, typename Q::luminosity, typename Q::moles>
              angular,
@@ -537,8 +573,9 @@ toLinear(Quantity<typename Q::mass, typename Q::length, typename Q::time, typena
 
 // Convert an linear unit `Q` to a angular unit correctly;
 // mostly useful for velocities
-template <isQuantity Q> Quantity<typename Q::mass, typename Q::angle, typename Q::time, typename Q::current,
-                                 typename Q::length, typename Q::temperature, typename Q::luminosity, typename Q::moles>
+template <isQuantity Q>
+constexpr Quantity<typename Q::mass, typename Q::angle, typename Q::time, typename Q::current, typename Q::length,
+                   typename Q::temperature, typename Q::luminosity, typename Q::moles>
 toAngular(Quantity<typename Q::mass, typename Q::length, typename Q::time, typename Q::current, typename Q::angle,
                    typename Q::temperature, typename Q::luminosity, typename Q::moles>
               linear,
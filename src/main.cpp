@@ -1,11 +1,25 @@
 #include "main.h"
+#include "units/Config.hpp"
+#include "units/DCMotorModel.hpp"
+#include "units/Formatter.hpp"
+#include "units/Parse.hpp"
+#include "units/PathFollower.hpp"
 #include "units/Pose.hpp"
+#include "units/Published.hpp"
 #include "units/Temperature.hpp"
+#include "units/Timestamp.hpp"
+#include "units/TrapezoidProfile.hpp"
 #include "units/Vector2D.hpp"
 #include "units/Vector3D.hpp"
+#include <atomic>
 
 constexpr int r2i(double value) { return static_cast<int>(value >= 0.0 ? value + 0.5 : value - 0.5); }
 
+// benchmarks run on the brain, and are only built with make EXTRA_CXXFLAGS=-DUNITS_BENCHMARK
+#ifdef UNITS_BENCHMARK
+void publishedBenchmark();
+#endif
+
 /**
  * Runs initialization code. This occurs as soon as the program is started.
  *
@@ -43,6 +57,9 @@ void initialize() {
     units::Vector2D<Area> v2c = 2_in * units::V2Position(2_in, 2_in);
     units::Vector2D<Area> v2d = units::V2Position(2_in, 2_in) * 2_in;
     units::Vector2D<Number> v2e = units::V2Position(2_in, 2_in) / 2_in;
+#ifdef UNITS_BENCHMARK
+    publishedBenchmark();
+#endif
 }
 
 void angleTests() {
@@ -51,4 +68,174 @@ void angleTests() {
     static_assert(r2i(to_stDeg(30_cDeg)) == r2i(to_stDeg(60_stDeg)));
     static_assert(r2i(to_stDeg(+0_cDeg)) == r2i(to_stDeg(90_stDeg)));
     Angle a = 2_cDeg;
-}
\ No newline at end of file
+}
+
+void trapezoidProfileTests() {
+    // a goal velocity that can't be reached within the distance is approached on a single ramp, without overshooting
+    static constexpr units::TrapezoidProfile<Length> profile(units::MotionState<Length>(), 1_cm, 1_mps, 2_mps2, 1_mps);
+    static_assert(r2i(to_msec(profile.duration())) == 100);
+    static_assert(r2i(to_mmps(profile.sample(profile.duration()).velocity)) == 200);
+    static_assert([] {
+        for (int i = 0; i <= 120; i++) {
+            if (profile.sample(i * 1_msec).position > 1_cm) return false;
+        }
+        return true;
+    }());
+}
+
+void pathFollowerTests() {
+    // a straight path along the x axis from 0 to 10 m, with points every 10 cm
+    static constexpr std::array<units::V2Position, 101> path = [] {
+        std::array<units::V2Position, 101> points;
+        for (int i = 0; i < 101; i++) points[i] = units::V2Position(i * 10_cm, 0_m);
+        return points;
+    }();
+    // a robot that starts partway along the path looks ahead of itself, not back at the start
+    static_assert([] {
+        units::PathFollower follower(path, 50_cm);
+        const units::V2Position target = follower.update(units::V2Position(3_m, 0_m));
+        return r2i(to_cm(target.x)) == 350 && r2i(to_cm(target.y)) == 0 && follower.index() == 34;
+    }());
+    // a robot that drives alongside the path, further away than the lookahead, merges in where it is
+    static_assert([] {
+        units::PathFollower follower(path, 50_cm);
+        for (int i = 0; i <= 80; i++) follower.update(units::V2Position(i * 10_cm, 60_cm));
+        const units::V2Position target = follower.update(units::V2Position(8_m, 30_cm));
+        return r2i(to_cm(target.x)) == 840 && r2i(to_cm(target.y)) == 0;
+    }());
+}
+
+void motorModelTests() {
+    // the model is symmetric in both directions
+    constexpr units::DCMotorModel motor = units::DCMotorModel::v5(pros::MotorGears::green);
+    static_assert(motor.freeSpeed(-12_volt) == -motor.freeSpeed(12_volt));
+    static_assert(motor.stallTorque(-12_volt) == -motor.stallTorque(12_volt));
+    static_assert(motor.torque(-100_rpm, -6_volt) == -motor.torque(100_rpm, 6_volt));
+    static_assert(r2i(to_Nm(motor.torque(-100_rpm, motor.voltage(-100_rpm, -0.5_Nm))) * 1000) == -500);
+    static_assert(r2i(to_Nm(motor.torque(0_rpm, motor.voltage(0_rpm, -0.5_Nm))) * 1000) == -500);
+}
+
+void timestampTests() {
+    // timestamps don't wrap, so differences and comparisons stay correct past 2^32 microseconds (71.6 minutes)
+    static constexpr units::Timestamp start(0xFFFFFFFFull - 5000);
+    static constexpr units::Timestamp later = start + 4000_sec;
+    static_assert(later > start && start < later);
+    static_assert(r2i(to_sec(later - start)) == 4000 && later.microsSince(start) == 4000000000ll);
+    static_assert(later.micros() == 0xFFFFFFFFull - 5000 + 4000000000ull);
+    static_assert(later - 4000_sec == start);
+}
+
+void parseTests() {
+    // a bare number is only in base units for quantities that have no unit to write instead
+    static_assert(units::hasParsableUnit<Length>() && units::hasParsableUnit<Number>());
+    static_assert(!units::hasParsableUnit<Divided<Voltage, Length>>());
+}
+
+void configTests() {
+    // a line cut off by the end of the arena is dropped, instead of being read with a wrong value
+    static_assert([] {
+        units::Config<24, 4> config;
+        const bool complete = config.loadText("gearRatio = 0.75\nkP = 12000000\n");
+        return !complete && config.text("gearRatio") == "0.75" && !config.contains("kP") && config.keyCount() == 1;
+    }());
+}
+
+void formatterTests() {
+    // specs, including their unit, are parsed at compile time
+    static_assert([] {
+        constexpr std::string_view spec = ".2in}";
+        units::QuantityFormatSpec<Length> length;
+        return *length.parse(spec.begin(), spec.end()) == '}' && length.error() == nullptr;
+    }());
+    static_assert([] {
+        constexpr std::string_view spec = "rpm";
+        units::QuantityFormatSpec<Length> length;
+        length.parse(spec.begin(), spec.end());
+        return length.error() != nullptr;
+    }());
+    static_assert([] {
+        constexpr std::string_view spec = ".1in,deg}";
+        units::PoseFormatSpec<std::ratio<0>> pose;
+        return *pose.parse(spec.begin(), spec.end()) == '}' && pose.error() == nullptr;
+    }());
+    static_assert([] {
+        constexpr std::string_view spec = "in,cm";
+        units::PoseFormatSpec<std::ratio<0>> pose;
+        pose.parse(spec.begin(), spec.end());
+        return pose.error() != nullptr;
+    }());
+    // the std::formatter specializations only forward to these
+    char buffer[256];
+    char* out = units::QuantityFormatSpec<Length>().write(buffer, units::V2Position(1_in, 2_in));
+    out = units::QuantityFormatSpec<Length>().write(out, units::V3Position(1_in, 2_in, 3_in));
+    out = units::PoseFormatSpec<std::ratio<0>>().write(out, units::Pose(1_in, 2_in, 90_stDeg));
+#ifdef __cpp_lib_format
+    // compiles every std::formatter specialization. The format string is checked at compile time
+    std::string text = std::format("{:.2in} {:.1cm} {:mm} {:.1in,deg} {}", 12_in, units::V2Position(1_in, 2_in),
+                                   units::V3Position(1_in, 2_in, 3_in), units::Pose(1_in, 2_in, 90_stDeg), 1_mps);
+#endif
+}
+
+#ifdef UNITS_BENCHMARK
+/**
+ * Shares a pose between a writer task, which updates it every millisecond, and 3 lower priority reader tasks, which
+ * read it as fast as they can. Prints the worst time the writer waited to update the pose, and the total number of
+ * reads.
+ */
+template <typename Write, typename Read> void contend(const char* name, Write write, Read read) {
+    std::atomic<bool> running = true;
+    std::atomic<std::uint32_t> reads = 0;
+    auto reader = [&] {
+        volatile double sink = 0;
+        while (running) {
+            sink = sink + read().x.internal();
+            reads++;
+        }
+    };
+    pros::Task r1(reader, TASK_PRIORITY_DEFAULT - 1);
+    pros::Task r2(reader, TASK_PRIORITY_DEFAULT - 1);
+    pros::Task r3(reader, TASK_PRIORITY_DEFAULT - 1);
+    std::uint64_t worst = 0;
+    pros::Task writer(
+        [&] {
+            std::uint32_t now = pros::millis();
+            for (int i = 0; i < 2000; i++) {
+                const std::uint64_t start = pros::micros();
+                write(units::Pose(i * 1_in, i * 1_in, i * 1_stDeg));
+                worst = std::max(worst, pros::micros() - start);
+                pros::Task::delay_until(&now, 1);
+            }
+        },
+        TASK_PRIORITY_DEFAULT + 1);
+    writer.join();
+    running = false;
+    r1.join();
+    r2.join();
+    r3.join();
+    printf("%s: worst write %lu us, %lu reads\n", name, static_cast<unsigned long>(worst),
+           static_cast<unsigned long>(reads));
+}
+
+/**
+ * Benchmarks units::Published against a pros::Mutex, under contention
+ */
+void publishedBenchmark() {
+    units::Published<units::Pose> published;
+    contend("Published", [&](units::Pose pose) { published.publish(pose); }, [&] { return published.read(); });
+    pros::Mutex mutex;
+    units::Pose shared;
+    contend(
+        "pros::Mutex",
+        [&](units::Pose pose) {
+            mutex.take();
+            shared = pose;
+            mutex.give();
+        },
+        [&] {
+            mutex.take();
+            const units::Pose pose = shared;
+            mutex.give();
+            return pose;
+        });
+}
+#endif